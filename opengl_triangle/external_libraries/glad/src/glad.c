@@ -13,6 +13,12 @@
     Omit khrplatform: False
     Reproducible: False
 
+    Hand edits: lazy binding mode (gladLoadGLLoaderLazy), see lazy_resolve;
+    hashed extension set (gladHasExtension), see insert_ext;
+    per-context dispatch tables (GladGLContext), see context_procs.
+    The trampolines and context_procs expand the X-macro list in
+    glad_gl_procs.h.
+
     Commandline:
         --profile="core" --api="gl=4.6" --generator="c" --spec="gl" --extensions=""
     Online:
@@ -20,6 +26,7 @@
 */
 
 #include <stdio.h>
+#include <stddef.h>
 #include <stdlib.h>
 #include <string.h>
 #include <glad/glad.h>
@@ -165,96 +172,159 @@ struct gladGLversionStruct GLVersion = { 0, 0 };
 static int max_loaded_major;
 static int max_loaded_minor;
 
-static const char *exts = NULL;
-static int num_exts_i = 0;
-static char **exts_i = NULL;
-
-static int get_exts(void) {
-#ifdef _GLAD_IS_SOME_NEW_VERSION
-    if(max_loaded_major < 3) {
-#endif
-        exts = (const char *)glGetString(GL_EXTENSIONS);
-#ifdef _GLAD_IS_SOME_NEW_VERSION
-    } else {
-        int index;
+/*
+ * Extension set (hand edit): the names are hashed once into an
+ * open-addressing table when GL is loaded and kept until the next load,
+ * so has_ext / gladHasExtension is O(1). Entries are views into driver
+ * memory (GL_EXTENSIONS / glGetStringi strings live as long as the
+ * context), nothing is copied. Each GladGLContext owns its own set.
+ */
+struct gladExtEntry {
+    const char *name;
+    size_t length;
+    unsigned int hash;
+};
 
-        num_exts_i = 0;
-        glGetIntegerv(GL_NUM_EXTENSIONS, &num_exts_i);
-        if (num_exts_i > 0) {
-            exts_i = (char **)malloc((size_t)num_exts_i * (sizeof *exts_i));
-        }
+static struct gladExtSet global_exts = { NULL, 0 };
 
-        if (exts_i == NULL) {
-            return 0;
-        }
+/* FNV-1a; 0 is reserved for empty slots */
+static unsigned int hash_ext(const char *name, size_t length) {
+    unsigned int hash = 2166136261u;
+    size_t i;
+    for(i = 0; i < length; i++) {
+        hash ^= (unsigned char)name[i];
+        hash *= 16777619u;
+    }
+    return hash ? hash : 1u;
+}
 
-        for(index = 0; index < num_exts_i; index++) {
-            const char *gl_str_tmp = (const char*)glGetStringi(GL_EXTENSIONS, index);
-            size_t len = strlen(gl_str_tmp);
+static void insert_ext(struct gladExtSet *set, const char *name, size_t length) {
+    unsigned int hash = hash_ext(name, length);
+    size_t slot = hash & set->mask;
 
-            char *local_str = (char*)malloc((len+1) * sizeof(char));
-            if(local_str != NULL) {
-                memcpy(local_str, gl_str_tmp, (len+1) * sizeof(char));
-            }
-            exts_i[index] = local_str;
+    while(set->entries[slot].hash != 0) {
+        if(set->entries[slot].hash == hash && set->entries[slot].length == length &&
+            memcmp(set->entries[slot].name, name, length) == 0) {
+            return;
         }
+        slot = (slot + 1) & set->mask;
     }
-#endif
-    return 1;
+
+    set->entries[slot].name = name;
+    set->entries[slot].length = length;
+    set->entries[slot].hash = hash;
 }
 
-static void free_exts(void) {
-    if (exts_i != NULL) {
-        int index;
-        for(index = 0; index < num_exts_i; index++) {
-            free((char *)exts_i[index]);
-        }
-        free((void *)exts_i);
-        exts_i = NULL;
+static void free_exts(struct gladExtSet *set) {
+    free((void *)set->entries);
+    set->entries = NULL;
+    set->mask = 0;
+}
+
+/* Table with at least twice as many slots as names (load factor <= 0.5) */
+static int alloc_exts(struct gladExtSet *set, size_t count) {
+    size_t size = 16;
+    while(size < count * 2) {
+        size <<= 1;
+    }
+
+    set->entries = (struct gladExtEntry *)calloc(size, sizeof *set->entries);
+    if(set->entries == NULL) {
+        return 0;
     }
+    set->mask = size - 1;
+    return 1;
 }
 
-static int has_ext(const char *ext) {
+/* The query functions are passed by address so a lazy trampoline that
+ * patches itself on the first call is not called again on the next */
+static int get_exts(struct gladExtSet *set, int major,
+                    PFNGLGETSTRINGPROC *getString,
+                    PFNGLGETINTEGERVPROC *getIntegerv,
+                    PFNGLGETSTRINGIPROC *getStringi) {
+    free_exts(set);
+
 #ifdef _GLAD_IS_SOME_NEW_VERSION
-    if(max_loaded_major < 3) {
+    if(major < 3) {
 #endif
-        const char *extensions;
-        const char *loc;
-        const char *terminator;
-        extensions = exts;
-        if(extensions == NULL || ext == NULL) {
-            return 0;
+        const char *exts = (const char *)(*getString)(GL_EXTENSIONS);
+        const char *cursor;
+        size_t count = 0;
+
+        if(exts == NULL) {
+            return alloc_exts(set, 0);
         }
 
-        while(1) {
-            loc = strstr(extensions, ext);
-            if(loc == NULL) {
-                return 0;
-            }
+        for(cursor = exts; *cursor != '\0'; cursor++) {
+            if(*cursor == ' ') count++;
+        }
+        if(!alloc_exts(set, count + 1)) {
+            return 0;
+        }
 
-            terminator = loc + strlen(ext);
-            if((loc == extensions || *(loc - 1) == ' ') &&
-                (*terminator == ' ' || *terminator == '\0')) {
-                return 1;
+        cursor = exts;
+        while(*cursor != '\0') {
+            const char *space = strchr(cursor, ' ');
+            size_t length = space ? (size_t)(space - cursor) : strlen(cursor);
+            if(length > 0) {
+                insert_ext(set, cursor, length);
             }
-            extensions = terminator;
+            cursor += length;
+            while(*cursor == ' ') cursor++;
         }
 #ifdef _GLAD_IS_SOME_NEW_VERSION
     } else {
         int index;
-        if(exts_i == NULL) return 0;
-        for(index = 0; index < num_exts_i; index++) {
-            const char *e = exts_i[index];
+        int num_exts_i = 0;
+
+        (*getIntegerv)(GL_NUM_EXTENSIONS, &num_exts_i);
+        if(num_exts_i < 0) {
+            num_exts_i = 0;
+        }
+        if(!alloc_exts(set, (size_t)num_exts_i)) {
+            return 0;
+        }
 
-            if(exts_i[index] != NULL && strcmp(e, ext) == 0) {
-                return 1;
+        for(index = 0; index < num_exts_i; index++) {
+            const char *name = (const char*)(*getStringi)(GL_EXTENSIONS, (GLuint)index);
+            if(name != NULL) {
+                insert_ext(set, name, strlen(name));
             }
         }
     }
+#else
+    (void)major; (void)getIntegerv; (void)getStringi;
 #endif
+    return 1;
+}
+
+static int has_ext(const struct gladExtSet *set, const char *ext) {
+    size_t length;
+    unsigned int hash;
+    size_t slot;
+
+    if(set->entries == NULL || ext == NULL) {
+        return 0;
+    }
+
+    length = strlen(ext);
+    hash = hash_ext(ext, length);
+    slot = hash & set->mask;
+
+    while(set->entries[slot].hash != 0) {
+        if(set->entries[slot].hash == hash && set->entries[slot].length == length &&
+            memcmp(set->entries[slot].name, ext, length) == 0) {
+            return 1;
+        }
+        slot = (slot + 1) & set->mask;
+    }
 
     return 0;
 }
+
+int gladHasExtension(const char *ext) {
+    return has_ext(&global_exts, ext);
+}
 int GLAD_GL_VERSION_1_0 = 0;
 int GLAD_GL_VERSION_1_1 = 0;
 int GLAD_GL_VERSION_1_2 = 0;
@@ -1733,22 +1803,62 @@ static void load_GL_VERSION_4_6(GLADloadproc load) {
 	glad_glMultiDrawElementsIndirectCount = (PFNGLMULTIDRAWELEMENTSINDIRECTCOUNTPROC)load("glMultiDrawElementsIndirectCount");
 	glad_glPolygonOffsetClamp = (PFNGLPOLYGONOFFSETCLAMPPROC)load("glPolygonOffsetClamp");
 }
+/*
+ * Lazy binding (gladLoadGLLoaderLazy, added by hand to the generated file).
+ * Every entry point starts out pointing at a trampoline with the same
+ * signature. The first call resolves the real function through the loader,
+ * patches the pointer and forwards the call, so later calls go straight to
+ * the driver. Only the functions a program actually calls are ever looked up.
+ * Not thread-safe: like eager loading, it assumes one current context.
+ */
+static GLADloadproc lazy_load = NULL;
+static int lazy_resolved = 0;
+
+static void* lazy_resolve(const char *name) {
+    lazy_resolved++;
+    return lazy_load(name);
+}
+
+/* One trampoline per row of glad_gl_procs.h */
+#define GLAD_GL_PROC(vmaj, vmin, Name, PFN, params, args) \
+static void APIENTRY glad_lazy_gl##Name params { \
+	glad_gl##Name = (PFN)lazy_resolve("gl" #Name); \
+	glad_gl##Name args; \
+}
+#define GLAD_GL_PROC_RET(vmaj, vmin, Ret, Name, PFN, params, args) \
+static Ret APIENTRY glad_lazy_gl##Name params { \
+	glad_gl##Name = (PFN)lazy_resolve("gl" #Name); \
+	return glad_gl##Name args; \
+}
+#include "glad_gl_procs.h"
+#undef GLAD_GL_PROC
+#undef GLAD_GL_PROC_RET
+
+/* Points every entry point the context's version has at its trampoline */
+static void lazy_install(void) {
+#define GLAD_GL_PROC(vmaj, vmin, Name, PFN, params, args) \
+	if(GLAD_GL_VERSION_##vmaj##_##vmin) glad_gl##Name = glad_lazy_gl##Name;
+#define GLAD_GL_PROC_RET(vmaj, vmin, Ret, Name, PFN, params, args) \
+	GLAD_GL_PROC(vmaj, vmin, Name, PFN, params, args)
+#include "glad_gl_procs.h"
+#undef GLAD_GL_PROC
+#undef GLAD_GL_PROC_RET
+}
 static int find_extensionsGL(void) {
-	if (!get_exts()) return 0;
-	(void)&has_ext;
-	free_exts();
+	/* The table stays for gladHasExtension() */
+	if (!get_exts(&global_exts, max_loaded_major, &glad_glGetString, &glad_glGetIntegerv, &glad_glGetStringi)) return 0;
 	return 1;
 }
 
-static void find_coreGL(void) {
+/* "4.6 (Core Profile) Mesa ..." -> 4, 6; 0 if there is no version string */
+static int parse_version(const char *version, int *major, int *minor) {
 
     /* Thank you @elmindreda
      * https://github.com/elmindreda/greg/blob/master/templates/greg.c.in#L176
      * https://github.com/glfw/glfw/blob/master/src/context.c#L36
      */
-    int i, major, minor;
+    int i;
 
-    const char* version;
     const char* prefixes[] = {
         "OpenGL ES-CM ",
         "OpenGL ES-CL ",
@@ -1756,8 +1866,7 @@ static void find_coreGL(void) {
         NULL
     };
 
-    version = (const char*) glGetString(GL_VERSION);
-    if (!version) return;
+    if (!version) return 0;
 
     for (i = 0;  prefixes[i];  i++) {
         const size_t length = strlen(prefixes[i]);
@@ -1769,10 +1878,17 @@ static void find_coreGL(void) {
 
 /* PR #18 */
 #ifdef _MSC_VER
-    sscanf_s(version, "%d.%d", &major, &minor);
+    sscanf_s(version, "%d.%d", major, minor);
 #else
-    sscanf(version, "%d.%d", &major, &minor);
+    sscanf(version, "%d.%d", major, minor);
 #endif
+    return 1;
+}
+
+static void find_coreGL(void) {
+    int major, minor;
+
+    if (!parse_version((const char*) glGetString(GL_VERSION), &major, &minor)) return;
 
     GLVersion.major = major; GLVersion.minor = minor;
     max_loaded_major = major; max_loaded_minor = minor;
@@ -1831,3 +1947,102 @@ int gladLoadGLLoader(GLADloadproc load) {
 	return GLVersion.major != 0 || GLVersion.minor != 0;
 }
 
+int gladLoadGLLoaderLazy(GLADloadproc load) {
+	GLVersion.major = 0; GLVersion.minor = 0;
+	glGetString = (PFNGLGETSTRINGPROC)load("glGetString");
+	if(glGetString == NULL) return 0;
+	if(glGetString(GL_VERSION) == NULL) return 0;
+	lazy_load = load;
+	lazy_resolved = 0;
+	find_coreGL();
+	lazy_install();
+
+	if (!find_extensionsGL()) return 0;
+	return GLVersion.major != 0 || GLVersion.minor != 0;
+}
+
+int gladGetLazyResolveCount(void) {
+	return lazy_resolved;
+}
+
+/*
+ * Per-context dispatch tables (hand edit). One row per entry point: the
+ * core version that introduced it and where it lives in GladGLContext.
+ */
+struct gladContextProc {
+    int major;
+    int minor;
+    const char *name;
+    size_t offset;
+};
+
+static const struct gladContextProc context_procs[] = {
+    /* Not in glad_gl_procs.h, which only lists what the lazy loader defers */
+    { 1, 0, "glGetString", offsetof(GladGLContext, GetString) },
+#define GLAD_GL_PROC(vmaj, vmin, Name, PFN, params, args) \
+    { vmaj, vmin, "gl" #Name, offsetof(GladGLContext, Name) },
+#define GLAD_GL_PROC_RET(vmaj, vmin, Ret, Name, PFN, params, args) \
+    GLAD_GL_PROC(vmaj, vmin, Name, PFN, params, args)
+#include "glad_gl_procs.h"
+#undef GLAD_GL_PROC
+#undef GLAD_GL_PROC_RET
+};
+
+int gladLoadGLContext(GladGLContext *context, GLADloadproc load) {
+    PFNGLGETSTRINGPROC getString;
+    int major = 0, minor = 0;
+    size_t i;
+
+    memset(context, 0, sizeof *context);
+
+    getString = (PFNGLGETSTRINGPROC)load("glGetString");
+    if(getString == NULL) return 0;
+    if(!parse_version((const char*) getString(GL_VERSION), &major, &minor)) return 0;
+
+    context->versionMajor = major; context->versionMinor = minor;
+    context->VERSION_1_0 = (major == 1 && minor >= 0) || major > 1;
+    context->VERSION_1_1 = (major == 1 && minor >= 1) || major > 1;
+    context->VERSION_1_2 = (major == 1 && minor >= 2) || major > 1;
+    context->VERSION_1_3 = (major == 1 && minor >= 3) || major > 1;
+    context->VERSION_1_4 = (major == 1 && minor >= 4) || major > 1;
+    context->VERSION_1_5 = (major == 1 && minor >= 5) || major > 1;
+    context->VERSION_2_0 = (major == 2 && minor >= 0) || major > 2;
+    context->VERSION_2_1 = (major == 2 && minor >= 1) || major > 2;
+    context->VERSION_3_0 = (major == 3 && minor >= 0) || major > 3;
+    context->VERSION_3_1 = (major == 3 && minor >= 1) || major > 3;
+    context->VERSION_3_2 = (major == 3 && minor >= 2) || major > 3;
+    context->VERSION_3_3 = (major == 3 && minor >= 3) || major > 3;
+    context->VERSION_4_0 = (major == 4 && minor >= 0) || major > 4;
+    context->VERSION_4_1 = (major == 4 && minor >= 1) || major > 4;
+    context->VERSION_4_2 = (major == 4 && minor >= 2) || major > 4;
+    context->VERSION_4_3 = (major == 4 && minor >= 3) || major > 4;
+    context->VERSION_4_4 = (major == 4 && minor >= 4) || major > 4;
+    context->VERSION_4_5 = (major == 4 && minor >= 5) || major > 4;
+    context->VERSION_4_6 = (major == 4 && minor >= 6) || major > 4;
+
+    for(i = 0; i < sizeof(context_procs) / sizeof(context_procs[0]); i++) {
+        const struct gladContextProc *proc = &context_procs[i];
+        if(major > proc->major || (major == proc->major && minor >= proc->minor)) {
+            *(void **)((char *)context + proc->offset) = load(proc->name);
+        }
+    }
+
+    /* 0.0 loaded nothing above (not even GetString), so it fails too */
+    if((major == 0 && minor == 0) ||
+       !get_exts(&context->extensions, major,
+                 &context->GetString, &context->GetIntegerv, &context->GetStringi)) {
+        /* Leave nothing callable behind a failed load */
+        free_exts(&context->extensions);
+        memset(context, 0, sizeof *context);
+        return 0;
+    }
+    return 1;
+}
+
+void gladFreeGLContext(GladGLContext *context) {
+    free_exts(&context->extensions);
+}
+
+int gladContextHasExtension(const GladGLContext *context, const char *ext) {
+    return has_ext(&context->extensions, ext);
+}
@@ -1,20 +1,7 @@
 // ===============================
-// OpenGL function loader
+// Shared renderer (context, buffers, frame loop)
 // ===============================
-#include <glad/glad.h>
-
-// ===============================
-// Windowing + input + context
-// ===============================
-#include <GLFW/glfw3.h>
-
-#include <iostream>
-
-// ===============================
-// Forward declarations
-// ===============================
-void framebuffer_size_callback(GLFWwindow* window, int width, int height);
-void processInput(GLFWwindow* window);
+#include <renderer/sample_app.h>
 
 // ===============================
 // Window settings
@@ -53,176 +40,34 @@ void main()
 }
 )";
 
-int main()
-{
-    // ===============================
-    // 1. Initialize GLFW
-    // ===============================
-    glfwInit();
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
-    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
-
-#ifdef __APPLE__
-    glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
-#endif
-
-    // ===============================
-    // 2. Create window + context
-    // ===============================
-    GLFWwindow* window = glfwCreateWindow(
-        SCR_WIDTH,
-        SCR_HEIGHT,
-        "OpenGL Beginner Renderer : My First OpenGL TRIANGLE",
-        nullptr,
-        nullptr
-    );
-
-    if (!window)
-    {
-        std::cout << "Failed to create GLFW window\n";
-        glfwTerminate();
-        return -1;
-    }
-
-    glfwMakeContextCurrent(window);
-    glfwSetFramebufferSizeCallback(window, framebuffer_size_callback);
-
-    // ===============================
-    // 3. Load OpenGL functions (GLAD)
-    // ===============================
-    if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
-    {
-        std::cout << "Failed to initialize GLAD\n";
-        return -1;
-    }
-
-    // ===============================
-    // 4. Compile Shaders
-    // ===============================
-    int success;
-    char infoLog[512];
-
-    unsigned int vertexShader = glCreateShader(GL_VERTEX_SHADER);
-    glShaderSource(vertexShader, 1, &vertexShaderSource, nullptr);
-    glCompileShader(vertexShader);
-
-    glGetShaderiv(vertexShader, GL_COMPILE_STATUS, &success);
-    if (!success)
-    {
-        glGetShaderInfoLog(vertexShader, 512, nullptr, infoLog);
-        std::cout << "Vertex Shader Error:\n" << infoLog << "\n";
-    }
-
-    unsigned int fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
-    glShaderSource(fragmentShader, 1, &fragmentShaderSource, nullptr);
-    glCompileShader(fragmentShader);
-
-    glGetShaderiv(fragmentShader, GL_COMPILE_STATUS, &success);
-    if (!success)
-    {
-        glGetShaderInfoLog(fragmentShader, 512, nullptr, infoLog);
-        std::cout << "Fragment Shader Error:\n" << infoLog << "\n";
-    }
-
-    unsigned int shaderProgram = glCreateProgram();
-    glAttachShader(shaderProgram, vertexShader);
-    glAttachShader(shaderProgram, fragmentShader);
-    glLinkProgram(shaderProgram);
-
-    glGetProgramiv(shaderProgram, GL_LINK_STATUS, &success);
-    if (!success)
-    {
-        glGetProgramInfoLog(shaderProgram, 512, nullptr, infoLog);
-        std::cout << "Shader Link Error:\n" << infoLog << "\n";
-    }
-
-    glDeleteShader(vertexShader);
-    glDeleteShader(fragmentShader);
-
-    // ===============================
-    // 5. Vertex Data (CPU)
-    // ===============================
-    float vertices[] =
-    {
-        -0.5f, -0.5f, 0.0f, // left
-         0.5f, -0.5f, 0.0f, // right
-         0.0f,  0.5f, 0.0f  // top
-    };
-
-    // ===============================
-    // 6. VAO + VBO (GPU)
-    // ===============================
-    unsigned int VAO, VBO;
-
-    glGenVertexArrays(1, &VAO);
-    glGenBuffers(1, &VBO);
-
-    glBindVertexArray(VAO);
-
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBufferData(
-        GL_ARRAY_BUFFER,
-        sizeof(vertices),
-        vertices,
-        GL_STATIC_DRAW
-    );
-
-    glVertexAttribPointer(
-        0,
-        3,
-        GL_FLOAT,
-        GL_FALSE,
-        3 * sizeof(float),
-        (void*)0
-    );
-    glEnableVertexAttribArray(0);
-
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindVertexArray(0);
-
-    // ===============================
-    // 7. Render Loop
-    // ===============================
-    while (!glfwWindowShouldClose(window))
-    {
-        processInput(window);
-
-        glClearColor(0.1f, 0.1f, 0.15f, 1.0f);
-        glClear(GL_COLOR_BUFFER_BIT);
-
-        glUseProgram(shaderProgram);
-        glBindVertexArray(VAO);
-        glDrawArrays(GL_TRIANGLES, 0, 3);
-
-        glfwSwapBuffers(window);
-        glfwPollEvents();
-    }
-
-    // ===============================
-    // 8. Cleanup
-    // ===============================
-    glDeleteVertexArrays(1, &VAO);
-    glDeleteBuffers(1, &VBO);
-    glDeleteProgram(shaderProgram);
-
-    glfwTerminate();
-    return 0;
-}
-
 // ===============================
-// Input handling
+// Vertex Data (CPU)
 // ===============================
-void processInput(GLFWwindow* window)
+const float vertices[] =
 {
-    if (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS)
-        glfwSetWindowShouldClose(window, true);
-}
+    -0.5f, -0.5f, 0.0f, // left
+     0.5f, -0.5f, 0.0f, // right
+     0.0f,  0.5f, 0.0f  // top
+};
 
-// ===============================
-// Resize callback
-// ===============================
-void framebuffer_size_callback(GLFWwindow*, int width, int height)
+int main(int argc, char** argv)
 {
-    glViewport(0, 0, width, height);
+    // Everything else (window / headless / software backends, buffers,
+    // render loop and --flags) is shared with the rectangle sample
+    SampleDesc sample;
+    sample.label = "triangle";
+    sample.windowTitle = "OpenGL Beginner Renderer : My First OpenGL TRIANGLE";
+    sample.width = SCR_WIDTH;
+    sample.height = SCR_HEIGHT;
+
+    sample.mesh = { vertices, 3, nullptr, 0 };
+    sample.vertexShaderSource = vertexShaderSource;
+    sample.fragmentShaderSource = fragmentShaderSource;
+    sample.fragmentShaderCpu = { { 1.0f, 0.5f, 0.6f, 1.0f } }; // same color for the software backend
+    sample.clearColor[0] = 0.1f;
+    sample.clearColor[1] = 0.1f;
+    sample.clearColor[2] = 0.15f;
+    sample.clearColor[3] = 1.0f;
+
+    return runSample(argc, argv, sample);
 }
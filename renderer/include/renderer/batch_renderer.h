@@ -0,0 +1,99 @@
+#pragma once
+
+#include <renderer/gl_handle.h>
+#include <renderer/gl_state_cache.h>
+#include <renderer/instancing.h>
+#include <renderer/stream_buffer.h>
+
+#include <cstddef>
+#include <vector>
+
+// ===============================
+// Multi-draw indirect batch renderer
+// ===============================
+//
+// All meshes share one VBO (vec3 positions, location 0) and one EBO,
+// whose index type is the narrowest that fits the largest mesh (indices
+// are mesh-local, so the total vertex count does not matter). Each queued draw becomes one
+// DrawElementsIndirectCommand plus one InstanceData record; submit()
+// streams both through ring buffers and issues a single
+// glMultiDrawElementsIndirect. The vertex shader picks its record with
+// gl_DrawID from a shader storage buffer.
+//
+// Paths, picked from the context:
+// - GL 4.6, or 4.3 + GL_ARB_shader_draw_parameters : indirect
+// - anything older : one glDrawElementsBaseVertex per draw with the
+//   record passed as uniforms (same shaders' inputs, same picture)
+//
+// Per frame: draw() as often as needed, then exactly one submit().
+class BatchRenderer
+{
+public:
+    using MeshId = unsigned int;
+
+    BatchRenderer() = default;
+    BatchRenderer(const BatchRenderer&) = delete;
+    BatchRenderer& operator=(const BatchRenderer&) = delete;
+
+    // Shader sources matching the path this context will use
+    static const char* vertexShaderSource();
+    static const char* fragmentShaderSource();
+
+    // Register meshes before build(); positions are xyz triples
+    MeshId addMesh(const float* positions, size_t vertexCount, const unsigned int* indices, size_t indexCount);
+
+    // Uploads the shared buffers; `maxDraws` sizes the per-frame rings
+    bool build(size_t maxDraws);
+
+    void draw(MeshId mesh, const InstanceData& data);
+
+    // Issues everything queued since the last submit with `program`
+    void submit(GlStateCache& state, unsigned int program);
+
+    void destroy();
+
+    bool indirect() const { return useIndirect; }
+
+private:
+    struct MeshRange
+    {
+        unsigned int indexCount;
+        unsigned int firstIndex;
+        int baseVertex;
+    };
+
+    struct DrawElementsIndirectCommand
+    {
+        unsigned int count;
+        unsigned int instanceCount;
+        unsigned int firstIndex;
+        int baseVertex;
+        unsigned int baseInstance;
+    };
+
+    void submitDirect(GlStateCache& state, unsigned int program);
+
+    std::vector<float> positions;
+    std::vector<unsigned int> indices;
+    std::vector<MeshRange> meshes;
+    size_t maxMeshVertices = 0;
+    unsigned int indexType = 0;
+
+    std::vector<DrawElementsIndirectCommand> commands;
+    std::vector<InstanceData> drawData;
+    size_t drawCapacity = 0;
+
+    GlVertexArray vao;
+    GlBuffer vbo;
+    GlBuffer ebo;
+
+    StreamBuffer commandStream;
+    StreamBuffer dataStream;
+    size_t storageAlignment = 4;
+    bool useIndirect = false;
+
+    // Fallback path uniform locations (per program)
+    unsigned int uniformProgram = 0;
+    int transformLocation = -1;
+    int colorLocation = -1;
+};
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <renderer/gl_handle.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+// ===============================
+// Fixed-frame-count benchmark
+// ===============================
+//
+// Runs `warmup` frames untimed, then records `measured` frames:
+// - cpu_frame_ms : wall time from beginFrame() to endFrame()
+// - swap_ms      : time blocked between beginSwap() and endSwap()
+// - gpu_ms       : GL_TIME_ELAPSED from beginFrame() to beginSwap()
+//
+// GPU queries are read back a few frames late so timing never stalls
+// the pipeline. All methods are no-ops until start() is called.
+// Without GPU timing (software backend) no GL call is made at all.
+class FrameBenchmark
+{
+public:
+    // Needs a current GL context when gpuTiming is set
+    void start(unsigned long long warmup, unsigned long long measured, bool gpuTiming = true);
+
+    void beginFrame();
+    void beginSwap();
+    void endSwap();
+    void endFrame();
+
+    bool active() const { return running; }
+    bool finished() const { return running && frameIndex >= warmupFrames + measuredFrames; }
+
+    // Overrides the "renderer" field (defaults to GL_RENDERER, or "cpu")
+    void setRenderer(const std::string& name) { rendererName = name; }
+
+    // Extra scalar reported next to the timings (e.g. per-frame counters)
+    void addMetric(const std::string& name, double value);
+
+    // Drains pending GPU queries and writes the JSON report to `path`
+    // (stdout when path is empty). Needs the GL context still current.
+    bool report(const std::string& label, const std::string& path);
+
+private:
+    struct PendingQuery
+    {
+        GlQuery query;
+        long long sample = -1; // measured frame index, -1 = slot unused
+    };
+
+    void collectQuery(PendingQuery& slot, bool wait);
+
+    bool running = false;
+    unsigned long long warmupFrames = 0;
+    unsigned long long measuredFrames = 0;
+    unsigned long long frameIndex = 0;
+
+    double frameStart = 0.0;
+    double swapStart = 0.0;
+    double swapMs = 0.0;
+
+    std::string rendererName;
+    std::vector<std::pair<std::string, double>> metrics;
+    std::vector<PendingQuery> queries;
+    std::vector<double> cpuFrameMs;
+    std::vector<double> swapMsSamples;
+    std::vector<double> gpuMs;
+};
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <renderer/gl_handle.h>
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// ===============================
+// Asynchronous frame capture
+// ===============================
+//
+// capture() starts a glReadPixels into the next pixel-pack buffer of a
+// ring and fences it; nothing waits. A buffer is only mapped when the ring
+// comes back around to it, RING_SIZE frames later, by which time the copy
+// has long finished. Its pixels are then handed to an encoder thread that
+// writes them out, so neither the readback nor the PNG encoding stalls the
+// render loop.
+//
+// Files: DIR/frame_000000.png, or DIR/frame_000000_WxH.rgba with --capture-raw
+// (RGBA8, top row first, no header).
+class FrameCapture
+{
+public:
+    static const int RING_SIZE = 3;
+
+    // Frames handed to the encoder but not written yet; capture() waits for
+    // the encoder past this so a slow disk cannot eat all memory
+    static const size_t MAX_QUEUED = 8;
+
+    enum class Format
+    {
+        Png,
+        Raw
+    };
+
+    FrameCapture() = default;
+    ~FrameCapture();
+
+    FrameCapture(const FrameCapture&) = delete;
+    FrameCapture& operator=(const FrameCapture&) = delete;
+
+    // Creates the directory and starts the encoder thread (no GL work yet)
+    bool start(const std::string& directory, Format format);
+
+    // After drawing, before the swap: queues a readback of `framebuffer`'s
+    // first color buffer (0 = the default back buffer), and collects the
+    // frame captured RING_SIZE frames ago. Leaves `framebuffer` bound for
+    // reading and no pixel-pack buffer bound.
+    void capture(unsigned int framebuffer, int width, int height);
+
+    // Collects every frame still in the ring, waits until the encoder has
+    // written them all and frees the buffers. Needs the context current.
+    void finish();
+
+    bool enabled() const { return encoder.joinable(); }
+
+    unsigned long long framesCaptured() const { return captured; }
+    unsigned long long framesWritten() const;
+
+    // Collections whose fence had not signalled yet (the CPU blocked)
+    unsigned long long blockedReads() const { return blocked; }
+
+    // Time capture() spent waiting for the encoder to catch up
+    double encoderWaitMs() const { return queueWaitMs; }
+
+    void print(std::ostream& out) const;
+
+private:
+    struct Slot
+    {
+        GlBuffer buffer;
+        size_t bytes = 0; // allocated size
+        GlSync fence;
+        unsigned long long index = 0;
+        int width = 0;
+        int height = 0;
+    };
+
+    struct Job
+    {
+        unsigned long long index = 0;
+        int width = 0;
+        int height = 0;
+        std::vector<unsigned char> pixels; // bottom row first, as read
+    };
+
+    // Maps the slot's buffer and queues its pixels; clears the fence
+    void collect(Slot& slot);
+
+    void encodeLoop();
+    bool write(const Job& job) const;
+
+    std::string directory;
+    Format format = Format::Png;
+
+    Slot ring[RING_SIZE];
+    int next = 0;
+
+    std::thread encoder;
+    mutable std::mutex mutex;
+    std::condition_variable wake;    // encoder: work arrived or stopping
+    std::condition_variable drained; // capture(): the queue got shorter
+    std::deque<Job> queue;
+    std::vector<std::vector<unsigned char>> spare; // written pixel buffers, reused
+    bool stopping = false;
+    unsigned long long written = 0;
+    unsigned long long failed = 0;
+
+    unsigned long long captured = 0;
+    unsigned long long blocked = 0;
+    double queueWaitMs = 0.0;
+};
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <renderer/gl_handle.h>
+
+#include <ostream>
+
+// ===============================
+// Fence-based frame pacing
+// ===============================
+//
+// endFrame() drops a glFenceSync behind each frame's commands (swap
+// included). beginFrame() keeps at most `framesInFlight` of them
+// outstanding: if that many frames are still unfinished on the GPU, it
+// waits for the oldest before the CPU starts on the next one.
+//
+// - 1 frame in flight : CPU and GPU take turns, lowest and steadiest latency
+// - 3 frames in flight: CPU queues ahead, highest throughput (offline runs)
+//
+// Without init() every call is a no-op and pacing is left to the driver.
+class FramePacer
+{
+public:
+    static const int MAX_FRAMES_IN_FLIGHT = 3;
+
+    FramePacer() = default;
+    FramePacer(const FramePacer&) = delete;
+    FramePacer& operator=(const FramePacer&) = delete;
+
+    // Needs a current GL context; framesInFlight is clamped to [1, 3]
+    void init(int framesInFlight);
+
+    // Deletes outstanding fences without waiting on them
+    void destroy();
+
+    void beginFrame();
+    void endFrame();
+
+    bool enabled() const { return limit > 0; }
+    int framesInFlight() const { return limit; }
+
+    // Time spent in beginFrame() waiting on fences, over all frames
+    double averageWaitMs() const { return frames ? totalWaitMs / (double)frames : 0.0; }
+    double maxWaitMs() const { return worstWaitMs; }
+
+    // Frames whose fence had not signalled yet (the CPU actually blocked)
+    unsigned long long blockedFrames() const { return blocked; }
+
+    void print(std::ostream& out) const;
+
+private:
+    void waitOldest();
+
+    int limit = 0;
+
+    // FIFO of fences, oldest at `first`
+    GlSync fences[MAX_FRAMES_IN_FLIGHT];
+    int first = 0;
+    int pending = 0;
+
+    double totalWaitMs = 0.0;
+    double worstWaitMs = 0.0;
+    unsigned long long frames = 0;
+    unsigned long long blocked = 0;
+};
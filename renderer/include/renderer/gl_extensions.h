@@ -0,0 +1,10 @@
+#pragma once
+
+// ===============================
+// Runtime extension queries
+// ===============================
+
+// True if the current context advertises `name` (e.g. "GL_KHR_parallel_shader_compile")
+// O(1): looks the name up in the set glad hashed at load time, so fast-path
+// selection can ask as often as it likes
+bool hasGLExtension(const char* name);
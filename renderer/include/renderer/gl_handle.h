@@ -0,0 +1,216 @@
+#pragma once
+
+#include <glad/glad.h>
+
+#include <cstddef>
+#include <vector>
+
+// ===============================
+// Owning GL object handles
+// ===============================
+//
+// Move-only wrappers around one GL object name. The object is deleted when
+// the handle is destroyed or reset(), and a move hands ownership over, so
+// an early return can neither leak it nor delete it twice. A handle is
+// nothing but the name, and the traits below are inline, so using one
+// costs the same as the raw glGen*/glDelete* calls.
+//
+// Deleting needs the owning context current, like any GL call: declare
+// handles after whatever keeps the context alive, or reset() them first.
+//
+//   GlBuffer vbo = GlBuffer::create();
+//   glBindBuffer(GL_ARRAY_BUFFER, vbo.get());
+template <typename Traits>
+class GlHandle
+{
+public:
+    using Name = typename Traits::Name;
+
+    GlHandle() = default;
+    explicit GlHandle(Name name) : name(name) {}
+    ~GlHandle() { reset(); }
+
+    GlHandle(GlHandle&& other) noexcept : name(other.release()) {}
+    GlHandle& operator=(GlHandle&& other) noexcept
+    {
+        if (this != &other)
+            reset(other.release());
+        return *this;
+    }
+
+    GlHandle(const GlHandle&) = delete;
+    GlHandle& operator=(const GlHandle&) = delete;
+
+    // Arguments go to the glCreate* call (e.g. the shader stage)
+    template <typename... Args>
+    static GlHandle create(Args... args) { return GlHandle(Traits::create(args...)); }
+
+    Name get() const { return name; }
+    explicit operator bool() const { return name != Name(); }
+
+    // Gives the name up without deleting the object
+    Name release()
+    {
+        Name released = name;
+        name = Name();
+        return released;
+    }
+
+    // Deletes the current object (if any) and takes `replacement`
+    void reset(Name replacement = Name())
+    {
+        if (name != Name())
+            Traits::destroy(name);
+        name = replacement;
+    }
+
+private:
+    Name name = Name();
+};
+
+// ===============================
+// Object types
+// ===============================
+// The glGen*/glDelete* types also take whole arrays of names (see GlNamePool)
+
+struct GlBufferTraits
+{
+    using Name = GLuint;
+    static void generate(int count, Name* names) { glGenBuffers(count, names); }
+    static void remove(int count, const Name* names) { glDeleteBuffers(count, names); }
+
+    static Name create() { Name name = 0; generate(1, &name); return name; }
+    static void destroy(Name name) { remove(1, &name); }
+};
+
+struct GlVertexArrayTraits
+{
+    using Name = GLuint;
+    static void generate(int count, Name* names) { glGenVertexArrays(count, names); }
+    static void remove(int count, const Name* names) { glDeleteVertexArrays(count, names); }
+
+    static Name create() { Name name = 0; generate(1, &name); return name; }
+    static void destroy(Name name) { remove(1, &name); }
+};
+
+struct GlQueryTraits
+{
+    using Name = GLuint;
+    static void generate(int count, Name* names) { glGenQueries(count, names); }
+    static void remove(int count, const Name* names) { glDeleteQueries(count, names); }
+
+    static Name create() { Name name = 0; generate(1, &name); return name; }
+    static void destroy(Name name) { remove(1, &name); }
+};
+
+struct GlShaderTraits
+{
+    using Name = GLuint;
+    static Name create(GLenum stage) { return glCreateShader(stage); } // GL_VERTEX_SHADER, ...
+    static void destroy(Name name) { glDeleteShader(name); }
+};
+
+struct GlProgramTraits
+{
+    using Name = GLuint;
+    static Name create() { return glCreateProgram(); }
+    static void destroy(Name name) { glDeleteProgram(name); }
+};
+
+struct GlSyncTraits
+{
+    using Name = GLsync;
+    // Fence behind everything submitted so far
+    static Name create() { return glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0); }
+    static void destroy(Name name) { glDeleteSync(name); }
+};
+
+using GlBuffer = GlHandle<GlBufferTraits>;
+using GlVertexArray = GlHandle<GlVertexArrayTraits>;
+using GlQuery = GlHandle<GlQueryTraits>;
+using GlShader = GlHandle<GlShaderTraits>;
+using GlProgram = GlHandle<GlProgramTraits>;
+using GlSync = GlHandle<GlSyncTraits>;
+
+static_assert(sizeof(GlBuffer) == sizeof(GLuint), "a handle is just the GL name");
+static_assert(sizeof(GlSync) == sizeof(GLsync), "a handle is just the GL name");
+
+// ===============================
+// Bulk name allocation
+// ===============================
+//
+// For the glGen*/glDelete* types. acquire() hands out names generated
+// BLOCK at a time; retire() queues a handle's object and flush() deletes
+// every queued one in a single call. Streaming thousands of objects in and
+// out then costs two GL calls per block rather than two per object.
+//
+// Same context rule as the handles: destroy() (or the destructor) must run
+// while the context is current. GpuProfiler takes its timestamp queries
+// from a GlQueryPool.
+template <typename Traits>
+class GlNamePool
+{
+public:
+    using Name = typename Traits::Name;
+    static const int BLOCK = 64;
+
+    GlNamePool() = default;
+    ~GlNamePool() { destroy(); }
+
+    GlNamePool(const GlNamePool&) = delete;
+    GlNamePool& operator=(const GlNamePool&) = delete;
+
+    GlHandle<Traits> acquire()
+    {
+        if (spare.empty())
+        {
+            spare.resize(BLOCK);
+            Traits::generate(BLOCK, spare.data());
+            ++generateCalls;
+        }
+
+        Name name = spare.back();
+        spare.pop_back();
+        return GlHandle<Traits>(name);
+    }
+
+    // The object stays alive until the next flush()
+    void retire(GlHandle<Traits> handle)
+    {
+        if (handle)
+            retired.push_back(handle.release());
+    }
+
+    void flush()
+    {
+        if (retired.empty())
+            return;
+
+        Traits::remove((int)retired.size(), retired.data());
+        retired.clear();
+        ++deleteCalls;
+    }
+
+    // Deletes the retired objects and the names never handed out
+    void destroy()
+    {
+        flush();
+        if (!spare.empty())
+            Traits::remove((int)spare.size(), spare.data());
+        spare.clear();
+    }
+
+    size_t retiredCount() const { return retired.size(); }
+
+    // glGen* / glDelete* calls issued so far
+    unsigned long long generateCallCount() const { return generateCalls; }
+    unsigned long long deleteCallCount() const { return deleteCalls; }
+
+private:
+    std::vector<Name> spare;   // generated, not handed out yet
+    std::vector<Name> retired; // handed back, deleted by flush()
+    unsigned long long generateCalls = 0;
+    unsigned long long deleteCalls = 0;
+};
+
+using GlQueryPool = GlNamePool<GlQueryTraits>;
@@ -0,0 +1,21 @@
+#pragma once
+
+// ===============================
+// GL entry point loading
+// ===============================
+//
+// Eager: gladLoadGLLoader resolves every GL 1.0 - 4.6 entry point up front.
+// Lazy : gladLoadGLLoaderLazy points each one at a trampoline that resolves
+//        it on its first call, so startup only pays for the version query.
+// Either way the call is timed, so --benchmark can compare the two.
+struct GlLoadStats
+{
+    double milliseconds = 0.0;
+    bool lazy = false;
+};
+
+// `loader` must stay valid while GL is in use (lazy mode calls it later)
+bool loadGLFunctions(void* (*loader)(const char*), bool lazy, GlLoadStats& stats);
+
+// Entry points looked up so far (lazy mode; -1 when loaded eagerly)
+int resolvedGLFunctions(const GlLoadStats& stats);
@@ -0,0 +1,82 @@
+#pragma once
+
+// ===============================
+// Redundant GL state filter
+// ===============================
+//
+// Remembers the last value set for each piece of state it wraps and
+// skips the GL call when the new value is the same. Wrapped state:
+// - program, vertex array
+// - buffer bindings: GL_ARRAY_BUFFER, GL_ELEMENT_ARRAY_BUFFER (belongs to
+//   the VAO, so it is forgotten on every VAO change), GL_DRAW_INDIRECT_BUFFER
+// - active texture unit + 2D / 3D / 2D array / cube map bindings per unit
+// - blend enable + blend func, viewport, clear color
+//
+// Anything else is passed through untouched. Code that changes wrapped
+// state behind the cache's back (setup code, other libraries) must call
+// invalidate() afterwards, or the cache will skip a call it should not.
+//
+// One cache per GL context.
+class GlStateCache
+{
+public:
+    static const int MAX_TEXTURE_UNITS = 32;
+
+    struct Counters
+    {
+        unsigned long long issued = 0;
+        unsigned long long elided = 0;
+    };
+
+    GlStateCache() { invalidate(); }
+
+    void useProgram(unsigned int program);
+    void bindVertexArray(unsigned int vao);
+    void bindBuffer(unsigned int target, unsigned int buffer);
+
+    void activeTexture(unsigned int unit); // 0-based unit, not GL_TEXTURE0 + n
+    void bindTexture(unsigned int unit, unsigned int target, unsigned int texture);
+
+    void setBlend(bool enabled);
+    void blendFunc(unsigned int src, unsigned int dst);
+
+    void viewport(int x, int y, int width, int height);
+    void clearColor(float r, float g, float b, float a);
+
+    // Forget everything: the next call of each kind always reaches GL
+    void invalidate();
+
+    // Call once per frame; frame() then reports the frame just finished
+    void endFrame();
+
+    const Counters& frame() const { return lastFrame; }
+    const Counters& total() const { return totals; }
+
+private:
+    bool changed(bool differs);
+
+    static const unsigned int UNKNOWN = 0xFFFFFFFFu;
+
+    unsigned int program;
+    unsigned int vertexArray;
+    unsigned int arrayBuffer;
+    unsigned int elementBuffer;
+    unsigned int indirectBuffer;
+
+    unsigned int activeUnit;
+    unsigned int textures[MAX_TEXTURE_UNITS][4];
+
+    int blendEnabled; // -1 unknown
+    unsigned int blendSrc;
+    unsigned int blendDst;
+
+    int viewportRect[4];
+    bool viewportKnown;
+
+    float clear[4];
+    bool clearKnown;
+
+    Counters current;
+    Counters lastFrame;
+    Counters totals;
+};
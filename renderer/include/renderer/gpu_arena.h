@@ -0,0 +1,132 @@
+#pragma once
+
+#include <renderer/gl_handle.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+// ===============================
+// GPU buffer arena
+// ===============================
+//
+// One large buffer (immutable glBufferStorage on GL 4.4+, a fixed-size
+// glBufferData before) carved into ranges by a TLSF allocator. Free blocks
+// sit in a two-level table of lists, power of two first, then 16 linear
+// steps, with a bitmap over each level. allocate() and free() are O(1),
+// and neighbouring free blocks merge immediately.
+//
+// Everything is 4-byte granular. allocate() takes any alignment that is a
+// multiple of 4, e.g. 12 for a vec3 stride, so that offset / stride is a
+// valid base vertex.
+//
+// Ranges are named by an Id rather than an offset: defragment() packs the
+// live ranges to the front (copying their data on the GPU), which changes
+// offsets. Look them up with offset() when drawing.
+class GpuArena
+{
+public:
+    using Id = unsigned int;
+    static const Id INVALID = ~0u;
+
+    // TLSF table: power-of-two classes, each split into SL_COUNT steps
+    static const int SL_BITS = 4;
+    static const int SL_COUNT = 1 << SL_BITS;
+    static const int FL_COUNT = 32;
+
+    struct Stats
+    {
+        size_t capacity = 0;
+        size_t used = 0;        // bytes handed out (alignment padding excluded)
+        size_t free = 0;
+        size_t largestFree = 0;
+        size_t freeBlocks = 0;
+        size_t allocations = 0;
+        unsigned long long defragmentations = 0;
+
+        // 0 = all free space in one block ... 1 = scattered in tiny ones
+        double fragmentation() const { return free ? 1.0 - (double)largestFree / (double)free : 0.0; }
+    };
+
+    GpuArena() = default;
+    GpuArena(const GpuArena&) = delete;
+    GpuArena& operator=(const GpuArena&) = delete;
+
+    // Reserves `capacity` bytes (rounded up to 4) in a single buffer
+    bool create(size_t capacity);
+    void destroy();
+
+    bool valid() const { return (bool)storage; }
+
+    // INVALID when nothing fits, even after defragmenting
+    Id allocate(size_t size, size_t alignment = 4);
+    void free(Id id);
+
+    // glBufferSubData into the range
+    void upload(Id id, const void* data, size_t size);
+
+    size_t offset(Id id) const { return blocks[ranges[id]].offset; }
+    size_t size(Id id) const { return blocks[ranges[id]].requested; }
+
+    // Packs every live range to the front, leaving one free block at the end
+    void defragment();
+
+    unsigned int buffer() const { return storage.get(); }
+
+    Stats stats() const;
+    void print(std::ostream& out, const char* name) const;
+
+private:
+    struct Block
+    {
+        std::uint32_t offset = 0;
+        std::uint32_t size = 0;      // whole block
+        std::uint32_t requested = 0; // what allocate() was asked for
+        std::uint32_t alignment = 4;
+        int prevPhysical = -1;
+        int nextPhysical = -1;
+        int prevFree = -1;
+        int nextFree = -1;
+        bool isFree = false;
+    };
+
+    int newBlock();
+    void releaseBlock(int index);
+
+    void insertFree(int index);
+    void removeFree(int index);
+    int findFree(std::uint32_t size) const;
+
+    // Splits `size` bytes off the front of block `index`; returns the rest
+    int split(int index, std::uint32_t size);
+
+    // Empties the block table and every free list
+    void clearBlocks();
+
+    GlBuffer storage;
+    std::uint32_t capacity = 0;
+
+    std::vector<Block> blocks;
+    std::vector<int> spareBlocks; // unused entries of blocks[]
+
+    int freeHeads[FL_COUNT][SL_COUNT];
+    std::uint32_t firstLevelMap = 0;
+    std::uint32_t secondLevelMap[FL_COUNT] = {};
+
+    std::vector<int> ranges; // Id -> block, -1 = unused
+    std::vector<Id> spareIds;
+
+    size_t usedBytes = 0;
+    size_t freeBytes = 0; // sum of the free blocks, kept up to date
+    size_t liveRanges = 0;
+    unsigned long long defragmentations = 0;
+};
+
+// Static geometry packed by usage class: every mesh's vertices in one
+// arena, every mesh's indices in another
+struct GeometryArenas
+{
+    GpuArena vertices;
+    GpuArena indices;
+};
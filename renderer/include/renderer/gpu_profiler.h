@@ -0,0 +1,86 @@
+#pragma once
+
+#include <renderer/gl_handle.h>
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+// ===============================
+// GPU scope profiler
+// ===============================
+//
+// beginScope()/endScope() drop a glQueryCounter(GL_TIMESTAMP) on each
+// side, so scopes may nest. Every frame gets its own set of queries from
+// a ring of LATENCY frames; a frame's results are read when its slot
+// comes around again, LATENCY frames later. If the GPU still has not
+// finished by then the frame's results are dropped rather than waited
+// for, so profiling never stalls the pipeline. finish() waits for the
+// last LATENCY frames, which would otherwise never be read.
+//
+// All calls are no-ops until init().
+class GpuProfiler
+{
+public:
+    static const int LATENCY = 4;
+
+    struct ScopeStats
+    {
+        std::string name;
+        double totalMs = 0.0;
+        unsigned long long samples = 0;
+
+        double averageMs() const { return samples ? totalMs / (double)samples : 0.0; }
+    };
+
+    // Needs a current GL context
+    void init();
+    void destroy();
+
+    void beginFrame();
+    void endFrame();
+
+    // Blocks until every outstanding frame is collected; call once the
+    // last frame is submitted, before reading scopes() or print()
+    void finish();
+
+    void beginScope(const char* name);
+    void endScope();
+
+    bool enabled() const { return initialized; }
+
+    const std::vector<ScopeStats>& scopes() const { return stats; }
+    unsigned long long droppedFrames() const { return dropped; }
+
+    // One line per scope: name, average ms, sample count
+    void print(std::ostream& out) const;
+
+private:
+    struct Record
+    {
+        int scope;
+        int beginQuery; // index into the slot's query pool
+        int endQuery;
+    };
+
+    struct FrameSlot
+    {
+        std::vector<GlQuery> queries;
+        int usedQueries = 0;
+        std::vector<Record> records;
+        bool pending = false;
+    };
+
+    int scopeIndex(const char* name);
+    int timestamp(FrameSlot& slot);
+    void collect(FrameSlot& slot, bool wait = false);
+
+    bool initialized = false;
+    GlQueryPool queryPool; // names for every slot, generated in blocks
+    FrameSlot slots[LATENCY];
+    int current = 0;
+
+    std::vector<int> openScopes; // indices into the current slot's records
+    std::vector<ScopeStats> stats;
+    unsigned long long dropped = 0;
+};
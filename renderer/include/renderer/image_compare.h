@@ -0,0 +1,45 @@
+#pragma once
+
+#include <renderer/render_options.h>
+
+#include <string>
+#include <vector>
+
+// ===============================
+// Golden-image comparison
+// ===============================
+//
+// Two metrics over 8-bit RGBA images of the same size:
+// - per pixel: a pixel is "bad" when any channel differs by more than the
+//   tolerance (SSE2, 4 pixels per step)
+// - perceptual: SSIM of every 8x8 block, per color channel; the worst
+//   block decides
+//
+// An image matches when no pixel is bad, or when at most maxBadFraction
+// of the pixels are bad and even the worst block clears the SSIM
+// threshold. The fraction rejects a recolored shape (SSIM forgives a
+// uniform shift of brightness), the worst block rejects a small missing
+// or moved shape that a frame-wide mean would average away. What passes
+// is low-level noise: rounding, dithering, blend precision.
+struct ImageDiff
+{
+    unsigned long long badPixels = 0;
+    int maxDifference = 0; // largest channel difference, 0-255
+    double ssim = 1.0;     // worst block
+    bool matches = true;
+};
+
+// Both images top row first
+ImageDiff compareImages(const unsigned char* image, const unsigned char* reference, int width, int height,
+    int tolerance, double maxBadFraction, double minSsim);
+
+// Black where the images agree, blue -> red -> yellow as the largest
+// channel difference grows past the tolerance. RGBA, top row first.
+std::vector<unsigned char> diffHeatmap(const unsigned char* image, const unsigned char* reference, int width, int height,
+    int tolerance);
+
+// --compare: checks a rendered frame against options.compareReference,
+// prints the result and writes the heatmap on a mismatch.
+// flipVertically: rows are bottom-up, as glReadPixels returns them.
+// Returns false on a mismatch or when the reference cannot be read.
+bool checkReferenceImage(const RenderOptions& options, const unsigned char* rgba, int width, int height, bool flipVertically);
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+// ===============================
+// Image files
+// ===============================
+
+// Writes 8-bit RGBA pixels as a PNG (no compression, no zlib needed)
+// flipVertically: rows are stored bottom-up, as glReadPixels returns them
+bool writePng(const std::string& path, int width, int height, const unsigned char* rgba, bool flipVertically);
+
+// Reads an 8-bit RGB or RGBA PNG (not interlaced) into RGBA, top row first
+// RGB images get an opaque alpha channel
+bool readPng(const std::string& path, int& width, int& height, std::vector<unsigned char>& rgba);
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+// ===============================
+// Compact index buffers
+// ===============================
+//
+// Sample meshes are authored with 32-bit indices. buildIndexBuffer()
+// re-encodes them in the narrowest type the vertex count allows:
+// GL_UNSIGNED_BYTE up to 256 vertices, GL_UNSIGNED_SHORT up to 65536,
+// GL_UNSIGNED_INT beyond that.
+//
+// A bigger mesh is cut into chunks of consecutive triangles whose vertices
+// span at most 65536 indices. Each chunk stores its indices relative to its
+// lowest vertex and is drawn with that as the base vertex, so the vertex
+// buffer stays as it is. Every chunk costs a draw call, so chunking is only
+// kept while chunks average MIN_CHUNK_INDICES; a mesh with poor vertex
+// locality stays 32-bit in one piece.
+
+// One glDrawElementsBaseVertex worth of a mesh
+struct IndexChunk
+{
+    size_t firstIndex; // into the packed indices
+    size_t indexCount;
+    int baseVertex;
+};
+
+struct IndexBuffer
+{
+    static const size_t MIN_CHUNK_INDICES = 3 * 4096;
+
+    unsigned int type = 0; // GL_UNSIGNED_BYTE / SHORT / INT
+    size_t indexSize = 0;
+    size_t indexCount = 0;
+    std::vector<unsigned char> bytes; // ready for glBufferData
+    std::vector<IndexChunk> chunks;
+
+    // Compared to plain 32-bit indices
+    size_t bytesSaved() const { return indexCount * sizeof(unsigned int) - bytes.size(); }
+};
+
+// Narrowest index type that can address `vertexCount` vertices
+unsigned int indexTypeFor(size_t vertexCount);
+size_t indexTypeSize(unsigned int type);
+
+// Appends `indices` minus `base`, narrowed to `type`
+void packIndices(const unsigned int* indices, size_t count, unsigned int base, unsigned int type, std::vector<unsigned char>& out);
+
+// `compact` = false keeps 32-bit indices in one chunk (--wide-indices)
+IndexBuffer buildIndexBuffer(const unsigned int* indices, size_t indexCount, size_t vertexCount, bool compact = true);
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <renderer/gl_handle.h>
+
+#include <cstddef>
+#include <vector>
+
+// ===============================
+// Instanced drawing
+// ===============================
+//
+// Every instance reuses the sample's mesh (location 0) and adds
+// - location 1: vec4 transform (xy = offset, zw = scale)
+// - location 2: vec4 color
+// from an instance VBO stepped once per instance (glVertexAttribDivisor).
+// The instances are laid out as a grid covering the whole viewport so a
+// million copies still fit on screen.
+
+extern const char* instancedVertexShaderSource;
+extern const char* instancedFragmentShaderSource;
+
+struct InstanceData
+{
+    float transform[4];
+    float color[4];
+};
+
+// Grid of `count` cells covering clip space, in the samples' pink
+std::vector<InstanceData> layoutInstanceGrid(size_t count);
+
+class InstanceBuffer
+{
+public:
+    InstanceBuffer() = default;
+    InstanceBuffer(const InstanceBuffer&) = delete;
+    InstanceBuffer& operator=(const InstanceBuffer&) = delete;
+
+    // Fills the grid and uploads it (GL_STATIC_DRAW)
+    void create(size_t count);
+
+    // Adds the per-instance attributes to `vao` (locations 1 and 2)
+    void attach(unsigned int vao) const;
+
+    void destroy();
+
+    size_t count() const { return instanceCount; }
+
+private:
+    GlBuffer vbo;
+    size_t instanceCount = 0;
+};
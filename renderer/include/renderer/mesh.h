@@ -0,0 +1,94 @@
+#pragma once
+
+#include <renderer/gl_handle.h>
+#include <renderer/gpu_arena.h>
+#include <renderer/index_buffer.h>
+#include <renderer/stream_buffer.h>
+
+#include <cstddef>
+
+class GlStateCache;
+
+// ===============================
+// Sample geometry
+// ===============================
+
+// Positions only (vec3 at location 0), optionally indexed. Points at the
+// sample's own arrays, which must outlive the mesh.
+struct MeshData
+{
+    const float* positions;
+    size_t vertexCount;
+    const unsigned int* indices; // nullptr = glDrawArrays
+    size_t indexCount;
+};
+
+// ===============================
+// Buffer objects + draw submission
+// ===============================
+//
+// The static VAO + VBO (+ EBO) of one mesh, the optional --stream copy that
+// is re-uploaded through ring buffers every frame, and the draw calls for
+// either. Draws bind through the state cache.
+//
+// Indices are uploaded in the narrowest type that fits (see IndexBuffer);
+// a chunked mesh issues one draw per chunk.
+//
+// With --arena the static copy lives in shared GeometryArenas instead of
+// its own VBO/EBO; draws then look up the ranges' current offsets, so a
+// defragmented arena needs no rebinding.
+class MeshBuffers
+{
+public:
+    MeshBuffers() = default;
+    MeshBuffers(const MeshBuffers&) = delete;
+    MeshBuffers& operator=(const MeshBuffers&) = delete;
+
+    // Uploads the mesh (GL_STATIC_DRAW), or into `arenas` when given and
+    // they have room; leaves no VAO or buffer bound. `compactIndices` =
+    // false keeps them 32-bit.
+    void create(const MeshData& mesh, GeometryArenas* arenas = nullptr, bool compactIndices = true);
+
+    // --stream: a second VAO sourcing from per-frame ring regions of
+    // `regionBytes`. False (and nothing kept) if the rings cannot be created.
+    bool createStreaming(size_t regionBytes);
+
+    void destroy();
+
+    // Static VAO, e.g. to attach instance attributes to
+    unsigned int vertexArray() const { return vao.get(); }
+    bool streaming() const { return (bool)streamVao; }
+    bool inArena() const { return arenas != nullptr; }
+
+    // Empty for a non-indexed mesh
+    const IndexBuffer& indexBuffer() const { return packedIndices; }
+
+    void draw(GlStateCache& stateCache) const;
+    void drawInstanced(GlStateCache& stateCache, size_t instanceCount) const;
+
+    // Copies the mesh into this frame's ring region and draws that copy
+    void drawStreamed(GlStateCache& stateCache);
+
+private:
+    MeshData data = {};
+    IndexBuffer packedIndices;
+
+    // First vertex and first index byte of the static copy
+    int baseVertex() const;
+    size_t indexOffset() const;
+
+    // One draw per index chunk; instanceCount 0 = not instanced
+    void drawChunks(size_t firstByte, int firstVertex, size_t instanceCount) const;
+
+    GeometryArenas* arenas = nullptr;
+    GpuArena::Id vertexRange = GpuArena::INVALID;
+    GpuArena::Id indexRange = GpuArena::INVALID;
+
+    GlVertexArray vao;
+    GlBuffer vbo;
+    GlBuffer ebo;
+
+    GlVertexArray streamVao;
+    StreamBuffer streamVertices;
+    StreamBuffer streamIndices;
+};
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <renderer/render_target.h>
+
+// ===============================
+// Headless OpenGL context (EGL)
+// ===============================
+//
+// Creates a 3.3 core context without a window system and renders into
+// an FBO sized like the window would be. Tries the Mesa surfaceless
+// platform first (works on llvmpipe with no X server), then falls back
+// to the default EGL display with a 1x1 pbuffer.
+//
+// Usage:
+//   OffscreenContext offscreen;
+//   offscreen.create(width, height);                        // context current
+//   gladLoadGLLoader((GLADloadproc)OffscreenContext::getProcAddress);
+//   offscreen.createFramebuffer();                          // FBO bound
+//   ... render loop ... offscreen.present();
+//
+// Several contexts can live on different threads at once (one per
+// thread, shared EGL display). Drive each through its own GladGLContext
+// from gladLoadGLContext() rather than the glad_gl* globals.
+class OffscreenContext
+{
+public:
+    OffscreenContext() = default;
+    ~OffscreenContext();
+
+    OffscreenContext(const OffscreenContext&) = delete;
+    OffscreenContext& operator=(const OffscreenContext&) = delete;
+
+    // Creates the context and makes it current on the calling thread
+    bool create(int width, int height);
+
+    // Needs GL functions loaded; leaves the FBO bound as draw target
+    bool createFramebuffer();
+
+    // Ends a frame (there is nothing to swap, so this only flushes)
+    void present();
+
+    void destroy();
+
+    // GLADloadproc-compatible proc loader
+    static void* getProcAddress(const char* name);
+
+    unsigned int framebuffer() const { return target.framebuffer(); }
+    int width() const { return fbWidth; }
+    int height() const { return fbHeight; }
+
+private:
+    void* display = nullptr;
+    void* surface = nullptr;
+    void* context = nullptr;
+
+    RenderTargetPool targetPool;
+    RenderTarget target{ targetPool };
+
+    int fbWidth = 0;
+    int fbHeight = 0;
+};
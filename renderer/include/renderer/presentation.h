@@ -0,0 +1,65 @@
+#pragma once
+
+#include <renderer/render_options.h>
+
+#include <ostream>
+
+// ===============================
+// Presentation control
+// ===============================
+//
+// - PresentMode (see render_options.h) picks the swap interval instead of
+//   leaving it to driver defaults
+// - FrameLimiter caps the frame rate on the CPU (works without vsync too)
+// - PresentStats measures what actually reached the screen: effective FPS
+//   and how much the interval between presents jitters
+
+// glfwSwapInterval() argument for `mode`. Adaptive needs
+// *_EXT_swap_control_tear (`tearControl`) and falls back to vsync.
+int swapIntervalFor(PresentMode mode, bool benchmark, bool tearControl);
+
+// Sleeps most of the remaining frame time and spins the last stretch,
+// since sleep() alone overshoots by the scheduler's granularity.
+// A frame that runs late moves the schedule instead of bursting to catch up.
+class FrameLimiter
+{
+public:
+    // 0 = unlimited
+    void setTargetFps(double fps);
+
+    bool enabled() const { return periodMs > 0.0; }
+
+    // Call once per frame; returns when the next frame may start
+    void wait();
+
+private:
+    double periodMs = 0.0;
+    double nextFrameMs = 0.0;
+};
+
+class PresentStats
+{
+public:
+    // Call right after each swap / present
+    void framePresented();
+
+    unsigned long long presents() const { return count; }
+
+    double averageFps() const;
+    double averageIntervalMs() const;
+    double maxIntervalMs() const { return worstMs; }
+
+    // Standard deviation of the present-to-present interval
+    double jitterMs() const;
+
+    void print(std::ostream& out) const;
+
+private:
+    double lastMs = -1.0;
+    unsigned long long count = 0;
+
+    // Running sums over the intervals (count - 1 of them)
+    double sumMs = 0.0;
+    double sumSquaresMs = 0.0;
+    double worstMs = 0.0;
+};
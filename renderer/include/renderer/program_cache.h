@@ -0,0 +1,48 @@
+#pragma once
+
+#include <renderer/gl_handle.h>
+
+#include <cstdint>
+#include <string>
+
+// ===============================
+// On-disk program binary cache
+// ===============================
+//
+// Entries are keyed by a hash of both GLSL sources plus the driver's
+// GL_VENDOR / GL_RENDERER / GL_VERSION strings, and hold the output of
+// glGetProgramBinary. A missing, stale or rejected entry is a miss: the
+// caller (ShaderCompiler) compiles as usual and store()s the fresh binary.
+//
+// Needs GL 4.1 (glProgramBinary) and at least one binary format; on
+// anything else, or with an empty directory, it just compiles.
+class ProgramCache
+{
+public:
+    explicit ProgramCache(std::string directory);
+
+    // Needs a current GL context. A linked program, or 0 on miss.
+    GlProgram load(const char* vertexSource, const char* fragmentSource);
+
+    // Stores the binary of an already linked program
+    void store(const char* vertexSource, const char* fragmentSource, unsigned int program);
+
+    unsigned int hits() const { return hitCount; }
+    unsigned int misses() const { return missCount; }
+
+private:
+    void queryDriver();
+    std::uint64_t keyFor(const char* vertexSource, const char* fragmentSource) const;
+    std::string pathFor(std::uint64_t key) const;
+
+    std::string directory;
+    std::string vendor;
+    std::string renderer;
+    std::string version;
+
+    bool queried = false;
+    bool usable = false;
+
+    unsigned int hitCount = 0;
+    unsigned int missCount = 0;
+};
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <string>
+
+// ===============================
+// Startup options shared by the samples
+// ===============================
+
+// Where the GL context comes from
+// - Window   : GLFW window + default framebuffer
+// - Egl      : headless EGL context rendering into an FBO
+// - Software : no GL at all, CPU rasterizer
+enum class ContextBackend
+{
+    Window,
+    Egl,
+    Software
+};
+
+// Swap interval (window backend)
+// - Auto      : Immediate for --benchmark, Vsync otherwise
+// - Vsync     : 1
+// - Immediate : 0, uncapped
+// - Adaptive  : -1, vsync but late frames tear instead of waiting a refresh
+enum class PresentMode
+{
+    Auto,
+    Vsync,
+    Immediate,
+    Adaptive
+};
+
+struct RenderOptions
+{
+    ContextBackend backend = ContextBackend::Window;
+
+    // Frames to render before exiting
+    // 0 = until the window is closed (offscreen: a single frame)
+    // In benchmark mode: measured frames, after the warm-up
+    unsigned long long frames = 0;
+
+    // Benchmark mode: warm-up + measured frames, then a JSON report
+    bool benchmark = false;
+    unsigned long long warmupFrames = 60;
+    std::string benchmarkOut; // empty = stdout
+
+    // Resolve GL entry points on first call instead of all at startup
+    bool lazyGL = false;
+
+    // Program binary cache directory (empty = always compile)
+    std::string shaderCacheDir;
+
+    // Re-upload the geometry every frame through the streaming ring buffer
+    bool stream = false;
+
+    // Suballocate the static geometry from shared vertex / index arenas
+    bool arena = false;
+
+    // Keep 32-bit indices instead of the narrowest type that fits
+    bool wideIndices = false;
+
+    // Copies drawn with a single instanced call (0 = plain draw)
+    unsigned long long instances = 0;
+
+    // Distinct objects submitted through the multi-draw indirect batch
+    // renderer (rectangle sample; 0 = plain draw)
+    unsigned long long batch = 0;
+
+    // Time clear / draw / swap on the GPU and report per-scope averages
+    bool gpuProfile = false;
+
+    PresentMode presentMode = PresentMode::Auto;
+
+    // CPU-side frame rate cap (0 = off)
+    unsigned long long fpsLimit = 0;
+
+    // Cap on frames the GPU may lag behind the CPU, enforced with fences
+    // (1 = lowest latency ... 3 = highest throughput; 0 = leave it to the driver)
+    unsigned long long framesInFlight = 0;
+
+    // Window backend: draw only after input, resize, expose or a scene
+    // change, and otherwise sleep in the event wait (ignored by --benchmark)
+    bool idle = false;
+
+    // Window backend: render + swap on their own thread, the main thread
+    // only pumps events
+    bool renderThread = false;
+
+    // GL backends: write every frame to this directory through the
+    // asynchronous PBO readback (empty = off)
+    std::string captureDir;
+    bool captureRaw = false; // headerless RGBA8 instead of PNG
+
+    // Headless backends: compare the last frame with this PNG and exit with
+    // an error on a mismatch (empty = off); see image_compare.h
+    std::string compareReference;
+    unsigned long long compareTolerance = 2; // per channel, 0-255
+    double compareMaxBad = 0.001; // fraction of pixels allowed over tolerance
+    double compareMinSsim = 0.95; // worst 8x8 block
+    std::string compareDiffPath; // heatmap written on a mismatch (empty = diff.png)
+
+    // PNG of the last frame (headless backends)
+    std::string outputPath;
+
+    // Software backend: > 0 = binned rasterizer on this many threads
+    unsigned long long threads = 0;
+};
+
+enum class ParseResult
+{
+    Run,
+    Help, // --help: usage printed, nothing to render
+    Error // unknown or malformed argument, message printed
+};
+
+// Parses argv into options
+ParseResult parseRenderOptions(int argc, char** argv, RenderOptions& options);
+
+void printRenderUsage(const char* program);
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+// ===============================
+// Pooled render targets
+// ===============================
+//
+// Color (RGBA8) + depth/stencil renderbuffers behind one FBO. Storage is
+// allocated in buckets of BUCKET pixels per side, so a window dragged a few
+// pixels keeps rendering into the storage it already has; only the
+// viewport changes. Storage that stops fitting goes back to a small pool
+// instead of being deleted, so dragging back and forth between two sizes
+// does not churn VRAM either.
+//
+// RenderTarget::resize() only records the wanted size. The storage is
+// swapped lazily in bind(), which the owner calls once per frame, so any
+// number of resize events costs at most one reallocation per frame.
+class RenderTargetPool
+{
+public:
+    static const int BUCKET = 128;
+    static const size_t MAX_FREE = 2;
+
+    struct Storage
+    {
+        unsigned int fbo = 0;
+        unsigned int color = 0;
+        unsigned int depth = 0;
+        int width = 0;  // allocated size, a whole number of buckets
+        int height = 0;
+    };
+
+    RenderTargetPool() = default;
+    RenderTargetPool(const RenderTargetPool&) = delete;
+    RenderTargetPool& operator=(const RenderTargetPool&) = delete;
+
+    // Rounds up to whole buckets
+    static int bucketed(int size);
+
+    // Storage of exactly the bucketed size: a pooled one if available,
+    // otherwise newly allocated. fbo == 0 on failure.
+    Storage acquire(int width, int height);
+
+    // Keeps the storage for reuse; the oldest is deleted past MAX_FREE
+    void release(const Storage& storage);
+
+    // Needs the context current
+    void destroy();
+
+    unsigned long long allocations() const { return allocated; }
+    unsigned long long reuses() const { return reused; }
+
+private:
+    static void free(Storage& storage);
+
+    std::vector<Storage> freeList; // oldest first
+    unsigned long long allocated = 0;
+    unsigned long long reused = 0;
+};
+
+class RenderTarget
+{
+public:
+    explicit RenderTarget(RenderTargetPool& pool) : pool(pool) {}
+
+    RenderTarget(const RenderTarget&) = delete;
+    RenderTarget& operator=(const RenderTarget&) = delete;
+
+    // No GL work; takes effect at the next bind()
+    void resize(int newWidth, int newHeight);
+
+    // Makes the storage fit the requested size (reusing it when the
+    // bucket is unchanged) and binds the FBO. False if it is incomplete.
+    bool bind();
+
+    // Hands the storage back to the pool
+    void release();
+
+    unsigned int framebuffer() const { return storage.fbo; }
+    int width() const { return requestedWidth; }
+    int height() const { return requestedHeight; }
+
+private:
+    RenderTargetPool& pool;
+    RenderTargetPool::Storage storage;
+    int requestedWidth = 0;
+    int requestedHeight = 0;
+};
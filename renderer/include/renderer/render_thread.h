@@ -0,0 +1,80 @@
+#pragma once
+
+#include <renderer/spsc_queue.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+// ===============================
+// Dedicated render thread
+// ===============================
+//
+// The window thread keeps pumping events while the GL context, the frame
+// loop and the (possibly blocking) swap live on this thread, so neither
+// side stalls the other. Window events the renderer cares about reach it
+// through a lock-free SPSC queue that the frame loop drains once per frame.
+//
+// Usage (window thread):
+//   glfwMakeContextCurrent(nullptr);            // hand the context over
+//   renderThread.start([&] { glfwMakeContextCurrent(window); loop(); },
+//                      [] { glfwPostEmptyEvent(); });
+//   while (renderThread.running()) { glfwWaitEvents(); ... post(...) ... }
+//   renderThread.join();
+struct RenderCommand
+{
+    enum class Type
+    {
+        Resize, // framebuffer is now width x height
+        Redraw, // input or an expose event: the next frame must be drawn
+        Quit    // window asked to close
+    };
+
+    Type type = Type::Quit;
+    int width = 0;
+    int height = 0;
+};
+
+class RenderThread
+{
+public:
+    RenderThread() = default;
+    ~RenderThread();
+
+    RenderThread(const RenderThread&) = delete;
+    RenderThread& operator=(const RenderThread&) = delete;
+
+    // Runs `loop` on a new thread; running() stays true until it returns.
+    // `wake` is called right after that, so a window thread blocked waiting
+    // for events notices the loop has ended
+    void start(std::function<void()> loop, std::function<void()> wake = nullptr);
+
+    // Waits for the loop to return (no-op if it was never started)
+    void join();
+
+    bool running() const { return isRunning.load(std::memory_order_acquire); }
+
+    // Window thread only; false when the queue is full. Also wakes a render
+    // thread sleeping in waitForCommand()
+    bool post(const RenderCommand& command);
+
+    // Render thread only; pops the oldest pending command
+    bool poll(RenderCommand& command) { return commands.pop(command); }
+
+    // Render thread only; sleeps until a command is queued or `timeoutMs`
+    // passes (idle rendering). The queue itself stays lock-free: the mutex
+    // only guards going to sleep and being woken.
+    void waitForCommand(double timeoutMs);
+
+private:
+    // Far more than one frame's worth of window events
+    SpscQueue<RenderCommand, 256> commands;
+
+    std::mutex wakeMutex;
+    std::condition_variable wake;
+
+    std::thread thread;
+    std::atomic<bool> isRunning{ false };
+};
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <renderer/mesh.h>
+#include <renderer/software_rasterizer.h>
+
+#include <vector>
+
+// ===============================
+// Sample runner
+// ===============================
+//
+// Everything the samples used to repeat in their own main(): options,
+// context creation (GLFW window, headless EGL or the CPU rasterizer), GL
+// loading, shader compilation, buffer setup, the frame loop with all its
+// --flags, reporting and cleanup. A sample only describes what it draws.
+struct SampleDesc
+{
+    const char* label;       // benchmark report name
+    const char* windowTitle;
+    int width;
+    int height;
+
+    MeshData mesh;
+    const char* vertexShaderSource;
+    const char* fragmentShaderSource;
+    FlatFragmentShader fragmentShaderCpu; // same shader for --backend software
+    float clearColor[4];
+
+    // --batch: meshes the indirect batch alternates between, all indexed
+    // (empty = --batch is ignored)
+    std::vector<MeshData> batchMeshes;
+};
+
+// Parses argv, runs the sample and returns the process exit code
+int runSample(int argc, char** argv, const SampleDesc& sample);
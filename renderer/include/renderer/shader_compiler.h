@@ -0,0 +1,79 @@
+#pragma once
+
+#include <renderer/gl_handle.h>
+
+#include <string>
+#include <vector>
+
+class ProgramCache;
+
+// ===============================
+// Asynchronous shader compiler
+// ===============================
+//
+// submit() issues glCompileShader for both stages and glLinkProgram right
+// away without asking for any status, so the driver is free to compile
+// everything in parallel. poll() is called once per frame and only
+// inspects programs the driver reports as finished:
+// - with GL_KHR/ARB_parallel_shader_compile it checks
+//   GL_COMPLETION_STATUS_KHR and never blocks
+// - without it, it resolves one program per call (that query may wait,
+//   but the cost is spread over frames instead of one startup wall)
+//
+// Until a program is ready, program() hands out a flat-colored
+// placeholder that accepts the same position attribute (location 0).
+class ShaderCompiler
+{
+public:
+    using Handle = unsigned int;
+
+    explicit ShaderCompiler(ProgramCache* cache = nullptr);
+
+    // Needs a current GL context; `loader` resolves the extension entry point
+    void init(void* (*loader)(const char*));
+
+    Handle submit(const char* vertexSource, const char* fragmentSource);
+
+    // Non-blocking progress check, once per frame
+    void poll();
+
+    // Blocks until every submitted program is resolved
+    void finishAll();
+
+    // Ready program, or the placeholder while still compiling / on failure
+    unsigned int program(Handle handle) const;
+
+    bool ready(Handle handle) const;
+    bool pending() const { return pendingCount > 0; }
+    bool parallel() const { return parallelCompile; }
+
+    // Deletes every program (placeholder included); context must be current
+    void destroy();
+
+private:
+    enum class State
+    {
+        Compiling,
+        Ready,
+        Failed
+    };
+
+    struct Job
+    {
+        std::string vertexSource;
+        std::string fragmentSource;
+        GlShader vertexShader;
+        GlShader fragmentShader;
+        GlProgram program;
+        State state = State::Compiling;
+    };
+
+    bool completed(const Job& job) const;
+    void resolve(Job& job);
+
+    ProgramCache* cache;
+    std::vector<Job> jobs;
+    GlProgram placeholder;
+    unsigned int pendingCount = 0;
+    bool parallelCompile = false;
+};
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <renderer/gl_handle.h>
+
+// ===============================
+// GLSL compile + link
+// ===============================
+
+// Compiles both stages, links them and deletes the shader objects.
+// Errors are printed with the driver's info log; the program id is
+// returned either way, so the link status still has to be trusted to
+// the caller (same as the original inline block).
+//
+// Synchronous; ShaderCompiler uses it for its placeholder program only.
+GlProgram buildShaderProgram(const char* vertexSource, const char* fragmentSource);
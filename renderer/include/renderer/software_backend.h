@@ -0,0 +1,28 @@
+#pragma once
+
+#include <renderer/render_options.h>
+#include <renderer/software_rasterizer.h>
+
+#include <cstddef>
+
+// ===============================
+// --backend software
+// ===============================
+//
+// Everything a sample draws, in a form the CPU rasterizer understands:
+// the same vertices[] / indices[] arrays and the fragment shader's color.
+struct SoftwareScene
+{
+    const float* positions;
+    size_t vertexCount;
+    const unsigned int* indices; // nullptr = glDrawArrays
+    size_t indexCount;
+    FlatFragmentShader shader;
+    float clearColor[4];
+};
+
+// Runs the sample's frame loop without any GL context. Honors --frames,
+// --benchmark (CPU timings only), --output, --compare, --threads and
+// --instances.
+// Returns the exit code.
+int runSoftwareBackend(const RenderOptions& options, const char* label, const SoftwareScene& scene, int width, int height);
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// ===============================
+// CPU rasterizer
+// ===============================
+//
+// Reference renderer for machines without any GL driver. Consumes the
+// samples' own arrays (clip-space xyz with w = 1, optional indices) and
+// writes an RGBA8 framebuffer.
+//
+// Triangles are set up as integer edge functions in 28.4 fixed point and
+// walked in 8x8 tiles: tiles fully outside an edge are skipped, tiles
+// fully inside are filled without per-pixel tests, and partial tiles
+// evaluate one row of 8 pixels per step with AVX2 (8 lanes), SSE2 (2x4)
+// or plain C++, whichever the build targets. All paths produce the same
+// bits. Pixel centers and the top-left fill rule follow GL conventions,
+// so shared edges are drawn exactly once.
+
+// Bottom-up rows like the GL default framebuffer (row 0 = bottom),
+// padded to whole tiles so the kernels never need edge checks
+struct SoftwareFramebuffer
+{
+    static const int TILE = 8;
+
+    int width = 0;
+    int height = 0;
+    int stride = 0;       // pixels per row, multiple of TILE
+    int paddedHeight = 0; // multiple of TILE
+    std::vector<std::uint32_t> pixels; // RGBA8, R in the lowest byte
+
+    void resize(int newWidth, int newHeight);
+    void clear(const float color[4]);
+
+    std::uint32_t* row(int y) { return pixels.data() + (size_t)y * (size_t)stride; }
+
+    // Tightly packed copy (width * height * 4 bytes), still bottom-up
+    std::vector<unsigned char> readPixels() const;
+};
+
+// C++ counterpart of the samples' fragment shader, which writes one
+// constant FragColor
+struct FlatFragmentShader
+{
+    float color[4];
+};
+
+// Same float -> unorm8 conversion GL applies when writing RGBA8
+std::uint32_t packColor(const float color[4]);
+
+class SoftwareRasterizer
+{
+public:
+    // glDrawArrays(GL_TRIANGLES, 0, vertexCount)
+    static void drawArrays(
+        SoftwareFramebuffer& target,
+        const float* positions,
+        size_t vertexCount,
+        const FlatFragmentShader& shader
+    );
+
+    // glDrawElements(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, 0)
+    static void drawElements(
+        SoftwareFramebuffer& target,
+        const float* positions,
+        const unsigned int* indices,
+        size_t indexCount,
+        const FlatFragmentShader& shader
+    );
+
+    // One triangle, already in window coordinates (28.4 fixed point),
+    // clipped to the tile-aligned rectangle [minX, maxX) x [minY, maxY)
+    static void drawTriangleFixed(
+        SoftwareFramebuffer& target,
+        const std::int32_t x[3],
+        const std::int32_t y[3],
+        std::uint32_t color,
+        int minX, int minY, int maxX, int maxY
+    );
+
+    // Clip space -> 28.4 fixed-point window coordinates
+    static void toWindowFixed(const SoftwareFramebuffer& target, const float* position, std::int32_t& x, std::int32_t& y);
+
+    // "avx2", "sse2" or "scalar"
+    static const char* simdPath();
+};
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+// ===============================
+// Lock-free single-producer / single-consumer queue
+// ===============================
+//
+// Bounded ring for exactly one pushing thread and one popping thread.
+// The producer only writes `tail`, the consumer only writes `head`, so
+// each operation is one acquire load of the other side's index and one
+// release store of its own. The indices sit on separate cache lines to
+// keep the two threads from bouncing one line between cores.
+template <typename T, size_t Capacity>
+class SpscQueue
+{
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    // Producer thread; false when full
+    bool push(const T& item)
+    {
+        size_t tailIndex = tail.load(std::memory_order_relaxed);
+        if (tailIndex - head.load(std::memory_order_acquire) == Capacity)
+            return false;
+
+        items[tailIndex & (Capacity - 1)] = item;
+        tail.store(tailIndex + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer thread; false when empty
+    bool pop(T& item)
+    {
+        size_t headIndex = head.load(std::memory_order_relaxed);
+        if (headIndex == tail.load(std::memory_order_acquire))
+            return false;
+
+        item = items[headIndex & (Capacity - 1)];
+        head.store(headIndex + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Either thread; only a snapshot
+    bool empty() const
+    {
+        return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+    }
+
+private:
+    T items[Capacity];
+    alignas(64) std::atomic<size_t> head{ 0 };
+    alignas(64) std::atomic<size_t> tail{ 0 };
+};
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <renderer/gl_handle.h>
+
+#include <cstddef>
+
+// ===============================
+// Streaming ring buffer
+// ===============================
+//
+// One buffer split into 3 regions, one per frame in flight. The current
+// region is filled front to back; endFrame() drops a fence behind it and
+// moves on, beginFrame() waits on that fence before the region comes
+// around again (normally it signalled long ago, so nothing blocks).
+//
+// GL 4.4+: glBufferStorage with a persistent + coherent mapping, so
+//          allocate() is just a pointer bump and commit() does nothing.
+// Older : unsynchronized glMapBufferRange per allocation; the fences give
+//          the same guarantee, commit() unmaps before drawing.
+//
+// Per frame:
+//   stream.beginFrame();
+//   StreamBuffer::Allocation a = stream.allocate(bytes, alignment);
+//   memcpy(a.data, src, bytes);
+//   stream.commit();
+//   ... draw using a.offset ...
+//   stream.endFrame();
+class StreamBuffer
+{
+public:
+    static const int REGION_COUNT = 3;
+
+    struct Allocation
+    {
+        void* data = nullptr;   // nullptr when the region is full
+        size_t offset = 0;      // byte offset into buffer()
+    };
+
+    StreamBuffer() = default;
+    StreamBuffer(const StreamBuffer&) = delete;
+    StreamBuffer& operator=(const StreamBuffer&) = delete;
+
+    // Usable as any buffer type; all mapping goes through
+    // GL_COPY_WRITE_BUFFER so no VAO or vertex/index binding is touched
+    bool create(size_t regionSize);
+    void destroy();
+
+    void beginFrame();
+    Allocation allocate(size_t size, size_t alignment);
+    void commit();
+    void endFrame();
+
+    unsigned int buffer() const { return storage.get(); }
+    bool persistent() const { return persistentMapping; }
+
+    // Frames that had to wait for the GPU to release a region
+    unsigned long long stalls() const { return stallCount; }
+
+private:
+    GlBuffer storage;
+    size_t regionBytes = 0;
+
+    unsigned char* mapped = nullptr; // whole buffer (persistent) or current range
+    bool persistentMapping = false;
+
+    int region = 0;
+    size_t head = 0;
+    GlSync fences[REGION_COUNT];
+
+    unsigned long long stallCount = 0;
+};
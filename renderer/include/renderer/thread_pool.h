@@ -0,0 +1,68 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// ===============================
+// Work-stealing thread pool
+// ===============================
+//
+// parallelFor() deals the task indices out to per-worker queues in
+// contiguous blocks (neighbouring tiles stay on one core). Each worker
+// drains its own queue from the back and, once empty, steals from the
+// front of the others, so uneven tasks even out without a central queue.
+// The calling thread works as worker 0 until every task has finished.
+//
+// Queues are short mutex-guarded deques: tasks here are whole screen
+// tiles, so a lock per task is noise next to the work inside it.
+class ThreadPool
+{
+public:
+    using Task = std::function<void(size_t index, unsigned int worker)>;
+
+    // threadCount includes the caller; 0 = one per hardware thread
+    explicit ThreadPool(unsigned int threadCount = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    unsigned int size() const { return (unsigned int)queues.size(); }
+
+    // Runs task(i, worker) for every i in [0, count); blocks until done.
+    // Not reentrant: one parallelFor at a time per pool.
+    void parallelFor(size_t count, const Task& task);
+
+    // Tasks taken from another worker's queue since construction
+    std::uint64_t steals() const { return stealCount.load(); }
+
+private:
+    struct Queue
+    {
+        std::mutex mutex;
+        std::deque<size_t> items;
+    };
+
+    void workerLoop(unsigned int worker);
+    bool runOne(unsigned int worker);
+
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread> threads;
+
+    std::mutex wakeMutex;
+    std::condition_variable wake;
+    std::uint64_t generation = 0;
+    bool stopping = false;
+
+    const Task* currentTask = nullptr;
+    std::atomic<size_t> remaining{ 0 };
+    std::atomic<std::uint64_t> stealCount{ 0 };
+};
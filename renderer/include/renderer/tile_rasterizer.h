@@ -0,0 +1,72 @@
+#pragma once
+
+#include <renderer/instancing.h>
+#include <renderer/software_rasterizer.h>
+#include <renderer/thread_pool.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// ===============================
+// Binned multithreaded rasterizer
+// ===============================
+//
+// Front end (parallel over chunks of triangles): fetch vertices through
+// the index buffer, apply the per-instance transform, convert to fixed
+// point and append the triangle's id to every screen bin its bounds touch.
+// Each chunk has its own bin lists, so no locks and no atomics.
+//
+// Back end (parallel over bins, work-stealing): clear the bin, then draw
+// its triangles clipped to the bin, chunk by chunk - that is submission
+// order, so the image is identical to the single-threaded rasterizer and
+// to the GL path no matter how the bins were scheduled.
+class TileRasterizer
+{
+public:
+    // Bin edge in pixels; a multiple of SoftwareFramebuffer::TILE
+    static const int BIN_SIZE = 64;
+
+    // What one draw call hands the rasterizer (instances optional)
+    struct DrawCall
+    {
+        const float* positions = nullptr;
+        const unsigned int* indices = nullptr; // nullptr = non-indexed
+        size_t elementCount = 0;               // vertices or indices, 3 per triangle
+
+        const InstanceData* instances = nullptr; // nullptr = one copy
+        size_t instanceCount = 0;
+        FlatFragmentShader shader = {};          // used without instances
+    };
+
+    // threadCount: see ThreadPool (0 = all hardware threads)
+    explicit TileRasterizer(unsigned int threadCount = 0);
+
+    void render(SoftwareFramebuffer& target, const float clearColor[4], const DrawCall& draw);
+
+    unsigned int threads() const { return pool.size(); }
+    std::uint64_t steals() const { return pool.steals(); }
+
+private:
+    struct SetupTriangle
+    {
+        std::int32_t x[3];
+        std::int32_t y[3];
+        std::uint32_t color;
+    };
+
+    void binChunk(const SoftwareFramebuffer& target, const DrawCall& draw, size_t chunk);
+    void rasterBin(SoftwareFramebuffer& target, std::uint32_t clear, size_t bin);
+
+    ThreadPool pool;
+
+    int binsX = 0;
+    int binsY = 0;
+    size_t trianglesPerChunk = 0;
+    size_t triangleCount = 0;
+
+    std::vector<SetupTriangle> triangles;
+    // chunkBins[chunk * binCount + bin] = triangle ids, in order
+    std::vector<std::vector<std::uint32_t>> chunkBins;
+    size_t chunkCount = 0;
+};
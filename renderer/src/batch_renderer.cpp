@@ -0,0 +1,275 @@
+#include <glad/glad.h>
+
+#include <renderer/batch_renderer.h>
+#include <renderer/gl_extensions.h>
+#include <renderer/index_buffer.h>
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+// ===============================
+// Shaders
+// ===============================
+// Indirect path: per-draw records in an SSBO, indexed by gl_DrawID.
+// The body is shared; only the header differs between 4.6 core and
+// 4.3 + ARB_shader_draw_parameters.
+#define BATCH_INDIRECT_BODY \
+    "layout (location = 0) in vec3 aPos;\n" \
+    "\n" \
+    "struct DrawData\n" \
+    "{\n" \
+    "    vec4 transform;\n" \
+    "    vec4 color;\n" \
+    "};\n" \
+    "\n" \
+    "layout (std430, binding = 0) readonly buffer DrawBuffer\n" \
+    "{\n" \
+    "    DrawData draws[];\n" \
+    "};\n" \
+    "\n" \
+    "out vec4 drawColor;\n" \
+    "\n" \
+    "void main()\n" \
+    "{\n" \
+    "    DrawData draw = draws[gl_DrawID];\n" \
+    "    gl_Position = vec4(aPos.xy * draw.transform.zw + draw.transform.xy, aPos.z, 1.0);\n" \
+    "    drawColor = draw.color;\n" \
+    "}\n"
+
+static const char* batchVertexShader460 =
+    "#version 460 core\n"
+    BATCH_INDIRECT_BODY;
+
+static const char* batchVertexShader430 =
+    "#version 430 core\n"
+    "#extension GL_ARB_shader_draw_parameters : require\n"
+    "#define gl_DrawID gl_DrawIDARB\n"
+    BATCH_INDIRECT_BODY;
+
+// Fallback path: one draw call per record, record passed as uniforms
+static const char* batchVertexShader330 = R"(
+#version 330 core
+layout (location = 0) in vec3 aPos;
+
+uniform vec4 uTransform;
+uniform vec4 uColor;
+
+out vec4 drawColor;
+
+void main()
+{
+    gl_Position = vec4(aPos.xy * uTransform.zw + uTransform.xy, aPos.z, 1.0);
+    drawColor = uColor;
+}
+)";
+
+static const char* batchFragmentShader = R"(
+#version 330 core
+in vec4 drawColor;
+out vec4 FragColor;
+
+void main()
+{
+    FragColor = drawColor;
+}
+)";
+
+static bool indirectSupported()
+{
+    if (GLAD_GL_VERSION_4_6)
+        return true;
+    return GLAD_GL_VERSION_4_3 && hasGLExtension("GL_ARB_shader_draw_parameters");
+}
+
+const char* BatchRenderer::vertexShaderSource()
+{
+    if (GLAD_GL_VERSION_4_6)
+        return batchVertexShader460;
+    if (indirectSupported())
+        return batchVertexShader430;
+    return batchVertexShader330;
+}
+
+const char* BatchRenderer::fragmentShaderSource()
+{
+    return batchFragmentShader;
+}
+
+// ===============================
+// Mesh packing
+// ===============================
+BatchRenderer::MeshId BatchRenderer::addMesh(const float* meshPositions, size_t vertexCount, const unsigned int* meshIndices, size_t indexCount)
+{
+    MeshRange range;
+    range.indexCount = (unsigned int)indexCount;
+    range.firstIndex = (unsigned int)indices.size();
+    range.baseVertex = (int)(positions.size() / 3);
+
+    // Indices stay mesh-local; baseVertex rebases them at draw time
+    positions.insert(positions.end(), meshPositions, meshPositions + vertexCount * 3);
+    indices.insert(indices.end(), meshIndices, meshIndices + indexCount);
+    maxMeshVertices = std::max(maxMeshVertices, vertexCount);
+
+    meshes.push_back(range);
+    return (MeshId)(meshes.size() - 1);
+}
+
+bool BatchRenderer::build(size_t maxDraws)
+{
+    drawCapacity = maxDraws;
+    commands.reserve(maxDraws);
+    drawData.reserve(maxDraws);
+    useIndirect = indirectSupported();
+
+    vao = GlVertexArray::create();
+    vbo = GlBuffer::create();
+    ebo = GlBuffer::create();
+
+    glBindVertexArray(vao.get());
+
+    glBindBuffer(GL_ARRAY_BUFFER, vbo.get());
+    glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)(positions.size() * sizeof(float)), positions.data(), GL_STATIC_DRAW);
+
+    indexType = indexTypeFor(maxMeshVertices);
+    std::vector<unsigned char> packed;
+    packIndices(indices.data(), indices.size(), 0, indexType, packed);
+
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo.get());
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, (GLsizeiptr)packed.size(), packed.data(), GL_STATIC_DRAW);
+
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0);
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
+
+    if (!useIndirect)
+        return true;
+
+    GLint alignment = 4;
+    glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &alignment);
+    storageAlignment = alignment > 0 ? (size_t)alignment : 4;
+
+    // Room for a full frame of records plus alignment slack
+    if (!commandStream.create(maxDraws * sizeof(DrawElementsIndirectCommand) + 64) ||
+        !dataStream.create(maxDraws * sizeof(InstanceData) + storageAlignment))
+    {
+        std::cout << "Batch renderer: stream buffers unavailable, drawing one by one\n";
+        commandStream.destroy();
+        dataStream.destroy();
+        useIndirect = false;
+    }
+
+    return true;
+}
+
+// ===============================
+// Draw queue
+// ===============================
+void BatchRenderer::draw(MeshId mesh, const InstanceData& data)
+{
+    if (commands.size() == drawCapacity)
+        return;
+
+    const MeshRange& range = meshes[mesh];
+
+    DrawElementsIndirectCommand command;
+    command.count = range.indexCount;
+    command.instanceCount = 1;
+    command.firstIndex = range.firstIndex;
+    command.baseVertex = range.baseVertex;
+    command.baseInstance = 0;
+
+    commands.push_back(command);
+    drawData.push_back(data);
+}
+
+void BatchRenderer::submit(GlStateCache& state, unsigned int program)
+{
+    if (commands.empty())
+        return;
+
+    if (!useIndirect)
+    {
+        submitDirect(state, program);
+        return;
+    }
+
+    commandStream.beginFrame();
+    dataStream.beginFrame();
+
+    size_t commandBytes = commands.size() * sizeof(DrawElementsIndirectCommand);
+    size_t dataBytes = drawData.size() * sizeof(InstanceData);
+
+    StreamBuffer::Allocation commandAlloc = commandStream.allocate(commandBytes, sizeof(unsigned int));
+    StreamBuffer::Allocation dataAlloc = dataStream.allocate(dataBytes, storageAlignment);
+
+    if (commandAlloc.data && dataAlloc.data)
+    {
+        std::memcpy(commandAlloc.data, commands.data(), commandBytes);
+        std::memcpy(dataAlloc.data, drawData.data(), dataBytes);
+        commandStream.commit();
+        dataStream.commit();
+
+        state.useProgram(program);
+        state.bindVertexArray(vao.get());
+        state.bindBuffer(GL_DRAW_INDIRECT_BUFFER, commandStream.buffer());
+        glBindBufferRange(GL_SHADER_STORAGE_BUFFER, 0, dataStream.buffer(), (GLintptr)dataAlloc.offset, (GLsizeiptr)dataBytes);
+
+        glMultiDrawElementsIndirect(
+            GL_TRIANGLES,
+            indexType,
+            (void*)commandAlloc.offset,
+            (GLsizei)commands.size(),
+            0
+        );
+    }
+
+    commandStream.endFrame();
+    dataStream.endFrame();
+
+    commands.clear();
+    drawData.clear();
+}
+
+void BatchRenderer::submitDirect(GlStateCache& state, unsigned int program)
+{
+    if (program != uniformProgram)
+    {
+        uniformProgram = program;
+        transformLocation = glGetUniformLocation(program, "uTransform");
+        colorLocation = glGetUniformLocation(program, "uColor");
+    }
+
+    state.useProgram(program);
+    state.bindVertexArray(vao.get());
+
+    for (size_t i = 0; i < commands.size(); ++i)
+    {
+        const DrawElementsIndirectCommand& command = commands[i];
+
+        glUniform4fv(transformLocation, 1, drawData[i].transform);
+        glUniform4fv(colorLocation, 1, drawData[i].color);
+        glDrawElementsBaseVertex(
+            GL_TRIANGLES,
+            (GLsizei)command.count,
+            indexType,
+            (void*)(command.firstIndex * indexTypeSize(indexType)),
+            command.baseVertex
+        );
+    }
+
+    commands.clear();
+    drawData.clear();
+}
+
+void BatchRenderer::destroy()
+{
+    commandStream.destroy();
+    dataStream.destroy();
+
+    vao.reset();
+    vbo.reset();
+    ebo.reset();
+}
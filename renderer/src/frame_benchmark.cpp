@@ -0,0 +1,234 @@
+#include <glad/glad.h>
+
+#include <renderer/frame_benchmark.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+// Frames between issuing a GPU query and reading it back
+static const unsigned int QUERY_RING_SIZE = 4;
+
+static double nowMs()
+{
+    using namespace std::chrono;
+    return duration<double, std::milli>(steady_clock::now().time_since_epoch()).count();
+}
+
+void FrameBenchmark::start(unsigned long long warmup, unsigned long long measured, bool gpuTiming)
+{
+    running = true;
+    warmupFrames = warmup;
+    measuredFrames = measured;
+    frameIndex = 0;
+
+    cpuFrameMs.assign(measured, 0.0);
+    swapMsSamples.assign(measured, 0.0);
+    gpuMs.assign(measured, -1.0);
+
+    queries.clear();
+    if (!gpuTiming)
+        return;
+
+    queries.resize(QUERY_RING_SIZE);
+    for (PendingQuery& slot : queries)
+    {
+        slot.query = GlQuery::create();
+        slot.sample = -1;
+    }
+}
+
+// ===============================
+// Per-frame hooks
+// ===============================
+void FrameBenchmark::beginFrame()
+{
+    if (!running || finished())
+        return;
+
+    frameStart = nowMs();
+    swapMs = 0.0;
+
+    if (queries.empty())
+        return;
+
+    PendingQuery& slot = queries[frameIndex % QUERY_RING_SIZE];
+    collectQuery(slot, true);
+    glBeginQuery(GL_TIME_ELAPSED, slot.query.get());
+}
+
+void FrameBenchmark::beginSwap()
+{
+    if (!running || finished())
+        return;
+
+    if (!queries.empty())
+        glEndQuery(GL_TIME_ELAPSED);
+    swapStart = nowMs();
+}
+
+void FrameBenchmark::endSwap()
+{
+    if (!running || finished())
+        return;
+
+    swapMs = nowMs() - swapStart;
+}
+
+void FrameBenchmark::endFrame()
+{
+    if (!running || finished())
+        return;
+
+    double frameMs = nowMs() - frameStart;
+
+    if (frameIndex >= warmupFrames)
+    {
+        unsigned long long sample = frameIndex - warmupFrames;
+        cpuFrameMs[sample] = frameMs;
+        swapMsSamples[sample] = swapMs;
+
+        if (!queries.empty())
+            queries[frameIndex % QUERY_RING_SIZE].sample = (long long)sample;
+    }
+
+    ++frameIndex;
+
+    // Opportunistically pick up older results without waiting
+    for (PendingQuery& pending : queries)
+        collectQuery(pending, false);
+}
+
+void FrameBenchmark::collectQuery(PendingQuery& slot, bool wait)
+{
+    if (slot.sample < 0)
+        return;
+
+    if (!wait)
+    {
+        GLint available = 0;
+        glGetQueryObjectiv(slot.query.get(), GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available)
+            return;
+    }
+
+    GLuint64 elapsedNs = 0;
+    glGetQueryObjectui64v(slot.query.get(), GL_QUERY_RESULT, &elapsedNs);
+    gpuMs[slot.sample] = (double)elapsedNs / 1.0e6;
+    slot.sample = -1;
+}
+
+// ===============================
+// Report
+// ===============================
+// JSON has no nan / inf: a metric that came out non-finite (e.g. a rate
+// over a zero-length run) is written as null
+static void writeNumber(std::ostream& out, double value)
+{
+    if (std::isfinite(value))
+        out << value;
+    else
+        out << "null";
+}
+
+static void writeStats(std::ostream& out, const char* name, std::vector<double> samples, bool last)
+{
+    samples.erase(std::remove_if(samples.begin(), samples.end(), [](double s) { return s == -1.0 || !std::isfinite(s); }),
+        samples.end());
+    std::sort(samples.begin(), samples.end());
+
+    // Nearest-rank percentile
+    auto percentile = [&](double p) -> double
+    {
+        if (samples.empty())
+            return 0.0;
+        size_t rank = (size_t)(p / 100.0 * (double)samples.size() + 0.999999);
+        rank = std::min(std::max<size_t>(rank, 1), samples.size());
+        return samples[rank - 1];
+    };
+
+    double mean = 0.0;
+    for (double s : samples)
+        mean += s;
+    if (!samples.empty())
+        mean /= (double)samples.size();
+
+    char line[256];
+    std::snprintf(line, sizeof(line),
+        "  \"%s\": { \"p50\": %.4f, \"p95\": %.4f, \"p99\": %.4f, \"max\": %.4f, \"mean\": %.4f }%s\n",
+        name,
+        percentile(50.0),
+        percentile(95.0),
+        percentile(99.0),
+        samples.empty() ? 0.0 : samples.back(),
+        mean,
+        last ? "" : ",");
+    out << line;
+}
+
+void FrameBenchmark::addMetric(const std::string& name, double value)
+{
+    metrics.emplace_back(name, value);
+}
+
+bool FrameBenchmark::report(const std::string& label, const std::string& path)
+{
+    if (!running)
+        return false;
+
+    bool gpuTiming = !queries.empty();
+    for (PendingQuery& slot : queries)
+        collectQuery(slot, true);
+    queries.clear();
+
+    unsigned long long recorded = frameIndex > warmupFrames ? frameIndex - warmupFrames : 0;
+    cpuFrameMs.resize(recorded);
+    swapMsSamples.resize(recorded);
+    gpuMs.resize(recorded);
+
+    std::string renderer = rendererName;
+    if (renderer.empty())
+    {
+        const char* glRenderer = gpuTiming ? (const char*)glGetString(GL_RENDERER) : nullptr;
+        renderer = glRenderer ? glRenderer : "cpu";
+    }
+
+    std::ostringstream json;
+    json << "{\n"
+         << "  \"label\": \"" << label << "\",\n"
+         << "  \"renderer\": \"" << renderer << "\",\n"
+         << "  \"warmup_frames\": " << warmupFrames << ",\n"
+         << "  \"measured_frames\": " << recorded << ",\n";
+    for (const auto& metric : metrics)
+    {
+        json << "  \"" << metric.first << "\": ";
+        writeNumber(json, metric.second);
+        json << ",\n";
+    }
+    writeStats(json, "cpu_frame_ms", cpuFrameMs, false);
+    writeStats(json, "swap_ms", swapMsSamples, !gpuTiming);
+    if (gpuTiming)
+        writeStats(json, "gpu_ms", gpuMs, true);
+    json << "}\n";
+
+    running = false;
+
+    if (path.empty())
+    {
+        std::cout << json.str();
+        return true;
+    }
+
+    std::ofstream file(path);
+    if (!file)
+    {
+        std::cout << "Failed to write benchmark report: " << path << "\n";
+        return false;
+    }
+    file << json.str();
+    return true;
+}
@@ -0,0 +1,249 @@
+#include <glad/glad.h>
+
+#include <renderer/frame_capture.h>
+#include <renderer/image_io.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+FrameCapture::~FrameCapture()
+{
+    // finish() normally ran already; otherwise at least stop the thread
+    if (encoder.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_one();
+        encoder.join();
+    }
+}
+
+bool FrameCapture::start(const std::string& captureDirectory, Format captureFormat)
+{
+    std::error_code error;
+    std::filesystem::create_directories(captureDirectory, error);
+    if (error)
+    {
+        std::cout << "Failed to create capture directory " << captureDirectory << ": " << error.message() << "\n";
+        return false;
+    }
+
+    directory = captureDirectory;
+    format = captureFormat;
+    stopping = false;
+    encoder = std::thread(&FrameCapture::encodeLoop, this);
+    return true;
+}
+
+unsigned long long FrameCapture::framesWritten() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return written;
+}
+
+// ===============================
+// Readback (render thread)
+// ===============================
+void FrameCapture::capture(unsigned int framebuffer, int width, int height)
+{
+    if (!enabled() || width <= 0 || height <= 0)
+        return;
+
+    // The slot about to be reused holds the frame from RING_SIZE frames ago
+    Slot& slot = ring[next];
+    next = (next + 1) % RING_SIZE;
+    if (slot.fence)
+        collect(slot);
+
+    size_t bytes = (size_t)width * (size_t)height * 4;
+
+    if (!slot.buffer)
+        slot.buffer = GlBuffer::create();
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.buffer.get());
+
+    // Storage only changes when the frame outgrows it
+    if (slot.bytes < bytes)
+    {
+        glBufferData(GL_PIXEL_PACK_BUFFER, (GLsizeiptr)bytes, nullptr, GL_STREAM_READ);
+        slot.bytes = bytes;
+    }
+
+    // With a pack buffer bound the last argument is an offset: the copy is
+    // queued on the GPU and glReadPixels returns right away
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer);
+    glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, (void*)0);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    slot.fence = GlSync::create();
+    slot.index = captured++;
+    slot.width = width;
+    slot.height = height;
+}
+
+void FrameCapture::collect(Slot& slot)
+{
+    GLsync fence = slot.fence.get();
+
+    // Same pattern as FramePacer: flush on the first attempt only
+    GLenum result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+    if (result == GL_TIMEOUT_EXPIRED)
+    {
+        ++blocked;
+        do
+        {
+            result = glClientWaitSync(fence, 0, 1000000); // 1 ms
+        } while (result == GL_TIMEOUT_EXPIRED);
+    }
+    slot.fence.reset();
+
+    Job job;
+    job.index = slot.index;
+    job.width = slot.width;
+    job.height = slot.height;
+
+    size_t bytes = (size_t)slot.width * (size_t)slot.height * 4;
+
+    {
+        using namespace std::chrono;
+        steady_clock::time_point start = steady_clock::now();
+
+        std::unique_lock<std::mutex> lock(mutex);
+        drained.wait(lock, [this] { return queue.size() < MAX_QUEUED; });
+
+        if (!spare.empty())
+        {
+            job.pixels.swap(spare.back());
+            spare.pop_back();
+        }
+
+        queueWaitMs += duration<double, std::milli>(steady_clock::now() - start).count();
+    }
+    job.pixels.resize(bytes);
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.buffer.get());
+    void* mapped = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, (GLsizeiptr)bytes, GL_MAP_READ_BIT);
+    if (mapped)
+    {
+        std::memcpy(job.pixels.data(), mapped, bytes);
+        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    if (!mapped)
+    {
+        std::cout << "Capture: failed to map frame " << job.index << "\n";
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        queue.push_back(std::move(job));
+    }
+    wake.notify_one();
+}
+
+void FrameCapture::finish()
+{
+    if (!enabled())
+        return;
+
+    // Oldest first, so files finish in frame order
+    for (int i = 0; i < RING_SIZE; ++i)
+    {
+        Slot& slot = ring[(next + i) % RING_SIZE];
+        if (slot.fence)
+            collect(slot);
+        slot = Slot();
+    }
+    next = 0;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_one();
+    encoder.join();
+
+    spare.clear();
+}
+
+// ===============================
+// Encoder thread
+// ===============================
+void FrameCapture::encodeLoop()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+
+    for (;;)
+    {
+        wake.wait(lock, [this] { return stopping || !queue.empty(); });
+
+        // Drain everything before honouring the stop
+        if (queue.empty())
+            return;
+
+        Job job = std::move(queue.front());
+        queue.pop_front();
+        drained.notify_one();
+
+        lock.unlock();
+        bool ok = write(job);
+        lock.lock();
+
+        if (ok)
+            ++written;
+        else
+            ++failed;
+        spare.push_back(std::move(job.pixels));
+    }
+}
+
+bool FrameCapture::write(const Job& job) const
+{
+    char name[64];
+
+    // glReadPixels returns the bottom row first; both formats store top first
+    if (format == Format::Png)
+    {
+        std::snprintf(name, sizeof(name), "frame_%06llu.png", job.index);
+        return writePng((std::filesystem::path(directory) / name).string(), job.width, job.height, job.pixels.data(), true);
+    }
+
+    std::snprintf(name, sizeof(name), "frame_%06llu_%dx%d.rgba", job.index, job.width, job.height);
+    std::string path = (std::filesystem::path(directory) / name).string();
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file)
+    {
+        std::cout << "Failed to open " << path << " for writing\n";
+        return false;
+    }
+
+    size_t rowBytes = (size_t)job.width * 4;
+    for (int y = job.height - 1; y >= 0; --y)
+        file.write((const char*)job.pixels.data() + (size_t)y * rowBytes, (std::streamsize)rowBytes);
+
+    return (bool)file;
+}
+
+void FrameCapture::print(std::ostream& out) const
+{
+    unsigned long long done;
+    unsigned long long errors;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        done = written;
+        errors = failed;
+    }
+
+    char line[512];
+    std::snprintf(line, sizeof(line), "Frame capture: %llu/%llu frames written to %s (%llu failed), %llu blocked reads, %.3f ms waiting on the encoder\n",
+        done, captured, directory.c_str(), errors, blocked, queueWaitMs);
+    out << line;
+}
@@ -0,0 +1,85 @@
+#include <glad/glad.h>
+
+#include <renderer/frame_pacer.h>
+
+#include <chrono>
+#include <cstdio>
+
+void FramePacer::init(int framesInFlight)
+{
+    destroy();
+
+    limit = framesInFlight < 1 ? 1 : framesInFlight > MAX_FRAMES_IN_FLIGHT ? MAX_FRAMES_IN_FLIGHT : framesInFlight;
+    totalWaitMs = worstWaitMs = 0.0;
+    frames = blocked = 0;
+}
+
+void FramePacer::destroy()
+{
+    for (GlSync& fence : fences)
+        fence.reset();
+
+    first = 0;
+    pending = 0;
+    limit = 0;
+}
+
+// ===============================
+// Frame boundaries
+// ===============================
+void FramePacer::beginFrame()
+{
+    if (!enabled())
+        return;
+
+    using namespace std::chrono;
+    steady_clock::time_point start = steady_clock::now();
+
+    // The frame about to start counts too, so leave room for it
+    while (pending >= limit)
+        waitOldest();
+
+    double waitMs = duration<double, std::milli>(steady_clock::now() - start).count();
+    totalWaitMs += waitMs;
+    if (waitMs > worstWaitMs)
+        worstWaitMs = waitMs;
+    ++frames;
+}
+
+void FramePacer::endFrame()
+{
+    if (!enabled())
+        return;
+
+    int slot = (first + pending) % MAX_FRAMES_IN_FLIGHT;
+    fences[slot] = GlSync::create();
+    ++pending;
+}
+
+void FramePacer::waitOldest()
+{
+    GLsync fence = fences[first].get();
+
+    // Same pattern as StreamBuffer: flush on the first attempt only
+    GLenum result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+    if (result == GL_TIMEOUT_EXPIRED)
+    {
+        ++blocked;
+        do
+        {
+            result = glClientWaitSync(fence, 0, 1000000); // 1 ms
+        } while (result == GL_TIMEOUT_EXPIRED);
+    }
+
+    fences[first].reset();
+    first = (first + 1) % MAX_FRAMES_IN_FLIGHT;
+    --pending;
+}
+
+void FramePacer::print(std::ostream& out) const
+{
+    char line[128];
+    std::snprintf(line, sizeof(line), "Frame pacing (%d in flight): wait %.4f ms avg, %.4f ms max, %llu/%llu frames blocked\n",
+        limit, averageWaitMs(), maxWaitMs(), blocked, frames);
+    out << line;
+}
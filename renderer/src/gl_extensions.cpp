@@ -0,0 +1,9 @@
+#include <glad/glad.h>
+
+#include <renderer/gl_extensions.h>
+
+bool hasGLExtension(const char* name)
+{
+    // Hash set built by glad when GL was loaded
+    return gladHasExtension(name) != 0;
+}
@@ -0,0 +1,22 @@
+#include <glad/glad.h>
+
+#include <renderer/gl_loader.h>
+
+#include <chrono>
+
+bool loadGLFunctions(void* (*loader)(const char*), bool lazy, GlLoadStats& stats)
+{
+    using namespace std::chrono;
+
+    steady_clock::time_point start = steady_clock::now();
+    int loaded = lazy ? gladLoadGLLoaderLazy((GLADloadproc)loader) : gladLoadGLLoader((GLADloadproc)loader);
+    stats.milliseconds = duration<double, std::milli>(steady_clock::now() - start).count();
+    stats.lazy = lazy;
+
+    return loaded != 0;
+}
+
+int resolvedGLFunctions(const GlLoadStats& stats)
+{
+    return stats.lazy ? gladGetLazyResolveCount() : -1;
+}
@@ -0,0 +1,193 @@
+#include <glad/glad.h>
+
+#include <renderer/gl_state_cache.h>
+
+// ===============================
+// Bookkeeping
+// ===============================
+bool GlStateCache::changed(bool differs)
+{
+    if (differs)
+    {
+        ++current.issued;
+        ++totals.issued;
+    }
+    else
+    {
+        ++current.elided;
+        ++totals.elided;
+    }
+    return differs;
+}
+
+void GlStateCache::invalidate()
+{
+    program = UNKNOWN;
+    vertexArray = UNKNOWN;
+    arrayBuffer = UNKNOWN;
+    elementBuffer = UNKNOWN;
+    indirectBuffer = UNKNOWN;
+
+    activeUnit = UNKNOWN;
+    for (auto& unit : textures)
+        for (unsigned int& binding : unit)
+            binding = UNKNOWN;
+
+    blendEnabled = -1;
+    blendSrc = UNKNOWN;
+    blendDst = UNKNOWN;
+
+    viewportKnown = false;
+    clearKnown = false;
+}
+
+void GlStateCache::endFrame()
+{
+    lastFrame = current;
+    current = Counters();
+}
+
+// ===============================
+// Objects
+// ===============================
+void GlStateCache::useProgram(unsigned int newProgram)
+{
+    if (!changed(program != newProgram))
+        return;
+
+    glUseProgram(newProgram);
+    program = newProgram;
+}
+
+void GlStateCache::bindVertexArray(unsigned int vao)
+{
+    if (!changed(vertexArray != vao))
+        return;
+
+    glBindVertexArray(vao);
+    vertexArray = vao;
+
+    // The element buffer binding is part of the VAO we just switched to
+    elementBuffer = UNKNOWN;
+}
+
+void GlStateCache::bindBuffer(unsigned int target, unsigned int buffer)
+{
+    unsigned int* slot = nullptr;
+    switch (target)
+    {
+    case GL_ARRAY_BUFFER:         slot = &arrayBuffer; break;
+    case GL_ELEMENT_ARRAY_BUFFER: slot = &elementBuffer; break;
+    case GL_DRAW_INDIRECT_BUFFER: slot = &indirectBuffer; break;
+    default: break;
+    }
+
+    if (slot && !changed(*slot != buffer))
+        return;
+    if (!slot)
+        changed(true);
+
+    glBindBuffer(target, buffer);
+    if (slot)
+        *slot = buffer;
+}
+
+// ===============================
+// Textures
+// ===============================
+static int textureSlot(unsigned int target)
+{
+    switch (target)
+    {
+    case GL_TEXTURE_2D:       return 0;
+    case GL_TEXTURE_3D:       return 1;
+    case GL_TEXTURE_2D_ARRAY: return 2;
+    case GL_TEXTURE_CUBE_MAP: return 3;
+    default:                  return -1;
+    }
+}
+
+void GlStateCache::activeTexture(unsigned int unit)
+{
+    if (!changed(activeUnit != unit))
+        return;
+
+    glActiveTexture(GL_TEXTURE0 + unit);
+    activeUnit = unit;
+}
+
+void GlStateCache::bindTexture(unsigned int unit, unsigned int target, unsigned int texture)
+{
+    int slot = textureSlot(target);
+    bool tracked = slot >= 0 && unit < (unsigned int)MAX_TEXTURE_UNITS;
+
+    if (tracked && !changed(textures[unit][slot] != texture))
+        return;
+    if (!tracked)
+        changed(true);
+
+    activeTexture(unit);
+    glBindTexture(target, texture);
+
+    if (tracked)
+        textures[unit][slot] = texture;
+}
+
+// ===============================
+// Fixed-function state
+// ===============================
+void GlStateCache::setBlend(bool enabled)
+{
+    int value = enabled ? 1 : 0;
+    if (!changed(blendEnabled != value))
+        return;
+
+    if (enabled)
+        glEnable(GL_BLEND);
+    else
+        glDisable(GL_BLEND);
+    blendEnabled = value;
+}
+
+void GlStateCache::blendFunc(unsigned int src, unsigned int dst)
+{
+    if (!changed(blendSrc != src || blendDst != dst))
+        return;
+
+    glBlendFunc(src, dst);
+    blendSrc = src;
+    blendDst = dst;
+}
+
+void GlStateCache::viewport(int x, int y, int width, int height)
+{
+    bool same = viewportKnown &&
+        viewportRect[0] == x && viewportRect[1] == y &&
+        viewportRect[2] == width && viewportRect[3] == height;
+
+    if (!changed(!same))
+        return;
+
+    glViewport(x, y, width, height);
+    viewportRect[0] = x;
+    viewportRect[1] = y;
+    viewportRect[2] = width;
+    viewportRect[3] = height;
+    viewportKnown = true;
+}
+
+void GlStateCache::clearColor(float r, float g, float b, float a)
+{
+    bool same = clearKnown &&
+        clear[0] == r && clear[1] == g && clear[2] == b && clear[3] == a;
+
+    if (!changed(!same))
+        return;
+
+    glClearColor(r, g, b, a);
+    clear[0] = r;
+    clear[1] = g;
+    clear[2] = b;
+    clear[3] = a;
+    clearKnown = true;
+}
@@ -0,0 +1,485 @@
+#include <glad/glad.h>
+
+#include <renderer/gpu_arena.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+
+// Every offset and size is a multiple of this
+static const std::uint32_t GRANULE = 4;
+
+// Below this, one list per exact size (first level 0)
+static const std::uint32_t SMALL_BLOCK = GpuArena::SL_COUNT * GRANULE;
+
+// Keeps size + alignment arithmetic inside 32 bits
+static const size_t MAX_CAPACITY = (size_t)1 << 31;
+
+static std::uint32_t roundUp(std::uint32_t value, std::uint32_t multiple)
+{
+    return (value + multiple - 1) / multiple * multiple;
+}
+
+static int floorLog2(std::uint32_t value)
+{
+    int log = 0;
+    while (value >>= 1)
+        ++log;
+    return log;
+}
+
+static int lowestBit(std::uint32_t bits)
+{
+    int index = 0;
+    while (!(bits & 1u))
+    {
+        bits >>= 1;
+        ++index;
+    }
+    return index;
+}
+
+// ===============================
+// Size classes
+// ===============================
+// The list a block of `size` bytes lives in
+static void mapping(std::uint32_t size, int& firstLevel, int& secondLevel)
+{
+    if (size < SMALL_BLOCK)
+    {
+        firstLevel = 0;
+        secondLevel = (int)(size / GRANULE);
+        return;
+    }
+
+    int log = floorLog2(size);
+    firstLevel = log - floorLog2(SMALL_BLOCK) + 1;
+    secondLevel = (int)(size >> (log - GpuArena::SL_BITS)) - GpuArena::SL_COUNT;
+}
+
+// The first list whose every block holds at least `size` bytes
+static void mappingSearch(std::uint32_t size, int& firstLevel, int& secondLevel)
+{
+    if (size >= SMALL_BLOCK)
+        size += (1u << (floorLog2(size) - GpuArena::SL_BITS)) - 1;
+    mapping(size, firstLevel, secondLevel);
+}
+
+// ===============================
+// Lifetime
+// ===============================
+bool GpuArena::create(size_t bytes)
+{
+    destroy();
+
+    if (bytes == 0 || bytes > MAX_CAPACITY)
+    {
+        std::cout << "Arena size out of range: " << bytes << " bytes\n";
+        return false;
+    }
+
+    capacity = roundUp((std::uint32_t)bytes, GRANULE);
+
+    storage = GlBuffer::create();
+    glBindBuffer(GL_COPY_WRITE_BUFFER, storage.get());
+
+    // Immutable where available: the size never changes anyway, and the
+    // driver can place it knowing that
+    if (GLAD_GL_VERSION_4_4)
+        glBufferStorage(GL_COPY_WRITE_BUFFER, (GLsizeiptr)capacity, nullptr, GL_DYNAMIC_STORAGE_BIT);
+    else
+        glBufferData(GL_COPY_WRITE_BUFFER, (GLsizeiptr)capacity, nullptr, GL_STATIC_DRAW);
+
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+    ranges.clear();
+    spareIds.clear();
+    usedBytes = 0;
+    freeBytes = capacity;
+    liveRanges = 0;
+    defragmentations = 0;
+
+    // Everything starts as one free block
+    clearBlocks();
+    int whole = newBlock();
+    blocks[whole].size = capacity;
+    insertFree(whole);
+    return true;
+}
+
+void GpuArena::destroy()
+{
+    storage.reset();
+    capacity = 0;
+
+    blocks.clear();
+    spareBlocks.clear();
+    ranges.clear();
+    spareIds.clear();
+    usedBytes = 0;
+    freeBytes = 0;
+    liveRanges = 0;
+}
+
+void GpuArena::clearBlocks()
+{
+    for (auto& heads : freeHeads)
+    {
+        for (int& head : heads)
+            head = -1;
+    }
+    firstLevelMap = 0;
+    for (std::uint32_t& map : secondLevelMap)
+        map = 0;
+
+    blocks.clear();
+    spareBlocks.clear();
+}
+
+// ===============================
+// Block bookkeeping
+// ===============================
+int GpuArena::newBlock()
+{
+    if (!spareBlocks.empty())
+    {
+        int index = spareBlocks.back();
+        spareBlocks.pop_back();
+        blocks[index] = Block();
+        return index;
+    }
+
+    blocks.push_back(Block());
+    return (int)blocks.size() - 1;
+}
+
+void GpuArena::releaseBlock(int index)
+{
+    // size 0 marks an unused entry for stats()
+    blocks[index] = Block();
+    spareBlocks.push_back(index);
+}
+
+void GpuArena::insertFree(int index)
+{
+    int firstLevel, secondLevel;
+    mapping(blocks[index].size, firstLevel, secondLevel);
+
+    int& head = freeHeads[firstLevel][secondLevel];
+    blocks[index].isFree = true;
+    blocks[index].prevFree = -1;
+    blocks[index].nextFree = head;
+    if (head >= 0)
+        blocks[head].prevFree = index;
+    head = index;
+
+    firstLevelMap |= 1u << firstLevel;
+    secondLevelMap[firstLevel] |= 1u << secondLevel;
+}
+
+void GpuArena::removeFree(int index)
+{
+    int firstLevel, secondLevel;
+    mapping(blocks[index].size, firstLevel, secondLevel);
+
+    Block& block = blocks[index];
+    if (block.prevFree >= 0)
+        blocks[block.prevFree].nextFree = block.nextFree;
+    else
+        freeHeads[firstLevel][secondLevel] = block.nextFree;
+    if (block.nextFree >= 0)
+        blocks[block.nextFree].prevFree = block.prevFree;
+
+    block.prevFree = block.nextFree = -1;
+    block.isFree = false;
+
+    if (freeHeads[firstLevel][secondLevel] < 0)
+    {
+        secondLevelMap[firstLevel] &= ~(1u << secondLevel);
+        if (!secondLevelMap[firstLevel])
+            firstLevelMap &= ~(1u << firstLevel);
+    }
+}
+
+int GpuArena::findFree(std::uint32_t size) const
+{
+    int firstLevel, secondLevel;
+    mappingSearch(size, firstLevel, secondLevel);
+    if (firstLevel >= FL_COUNT)
+        return -1;
+
+    // Same power of two, big enough step...
+    std::uint32_t secondMap = secondLevelMap[firstLevel] & (~0u << secondLevel);
+    if (!secondMap)
+    {
+        // ...or else any larger power of two
+        std::uint32_t firstMap = firstLevel + 1 < FL_COUNT ? firstLevelMap & (~0u << (firstLevel + 1)) : 0;
+        if (!firstMap)
+            return -1;
+
+        firstLevel = lowestBit(firstMap);
+        secondMap = secondLevelMap[firstLevel];
+    }
+
+    return freeHeads[firstLevel][lowestBit(secondMap)];
+}
+
+int GpuArena::split(int index, std::uint32_t size)
+{
+    int rest = newBlock();
+
+    // newBlock() may have grown the vector: index again from here on
+    blocks[rest].offset = blocks[index].offset + size;
+    blocks[rest].size = blocks[index].size - size;
+    blocks[rest].prevPhysical = index;
+    blocks[rest].nextPhysical = blocks[index].nextPhysical;
+    if (blocks[rest].nextPhysical >= 0)
+        blocks[blocks[rest].nextPhysical].prevPhysical = rest;
+
+    blocks[index].size = size;
+    blocks[index].nextPhysical = rest;
+    return rest;
+}
+
+// ===============================
+// Allocation
+// ===============================
+GpuArena::Id GpuArena::allocate(size_t size, size_t alignment)
+{
+    if (!storage || size == 0 || size > capacity)
+        return INVALID;
+
+    std::uint32_t rounded = roundUp((std::uint32_t)size, GRANULE);
+    std::uint32_t align = roundUp((std::uint32_t)std::max<size_t>(alignment, GRANULE), GRANULE);
+
+    // Room for the worst-case padding in front
+    std::uint32_t needed = rounded + align - GRANULE;
+
+    int index = findFree(needed);
+    if (index < 0 && liveRanges > 0 && freeBytes >= needed)
+    {
+        // Enough space, just not in one piece
+        defragment();
+        index = findFree(needed);
+    }
+    if (index < 0)
+        return INVALID;
+
+    removeFree(index);
+
+    std::uint32_t padding = (align - blocks[index].offset % align) % align;
+    if (padding)
+    {
+        int aligned = split(index, padding);
+        insertFree(index);
+        index = aligned;
+    }
+
+    if (blocks[index].size > rounded)
+        insertFree(split(index, rounded));
+
+    Block& block = blocks[index];
+    block.isFree = false;
+    block.requested = (std::uint32_t)size;
+    freeBytes -= block.size;
+    block.alignment = align;
+
+    Id id;
+    if (!spareIds.empty())
+    {
+        id = spareIds.back();
+        spareIds.pop_back();
+    }
+    else
+    {
+        id = (Id)ranges.size();
+        ranges.push_back(-1);
+    }
+    ranges[id] = index;
+
+    usedBytes += size;
+    ++liveRanges;
+    return id;
+}
+
+void GpuArena::free(Id id)
+{
+    if (id == INVALID || id >= ranges.size() || ranges[id] < 0)
+        return;
+
+    int index = ranges[id];
+    usedBytes -= blocks[index].requested;
+    freeBytes += blocks[index].size;
+    --liveRanges;
+    ranges[id] = -1;
+    spareIds.push_back(id);
+
+    // Merge with free neighbours so free blocks never sit side by side
+    int prev = blocks[index].prevPhysical;
+    if (prev >= 0 && blocks[prev].isFree)
+    {
+        removeFree(prev);
+        blocks[prev].size += blocks[index].size;
+        blocks[prev].nextPhysical = blocks[index].nextPhysical;
+        if (blocks[prev].nextPhysical >= 0)
+            blocks[blocks[prev].nextPhysical].prevPhysical = prev;
+        releaseBlock(index);
+        index = prev;
+    }
+
+    int next = blocks[index].nextPhysical;
+    if (next >= 0 && blocks[next].isFree)
+    {
+        removeFree(next);
+        blocks[index].size += blocks[next].size;
+        blocks[index].nextPhysical = blocks[next].nextPhysical;
+        if (blocks[index].nextPhysical >= 0)
+            blocks[blocks[index].nextPhysical].prevPhysical = index;
+        releaseBlock(next);
+    }
+
+    insertFree(index);
+}
+
+void GpuArena::upload(Id id, const void* data, size_t size)
+{
+    glBindBuffer(GL_COPY_WRITE_BUFFER, storage.get());
+    glBufferSubData(GL_COPY_WRITE_BUFFER, (GLintptr)offset(id), (GLsizeiptr)size, data);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+}
+
+// ===============================
+// Defragmentation
+// ===============================
+void GpuArena::defragment()
+{
+    if (!storage)
+        return;
+
+    // Live ranges in address order, and where each one packs to
+    std::vector<Id> live;
+    for (Id id = 0; id < (Id)ranges.size(); ++id)
+    {
+        if (ranges[id] >= 0)
+            live.push_back(id);
+    }
+    std::sort(live.begin(), live.end(), [this](Id a, Id b) { return offset(a) < offset(b); });
+
+    std::vector<std::uint32_t> packed(live.size());
+    std::uint32_t cursor = 0;
+    std::uint32_t liveBytes = 0;
+    bool moves = false;
+
+    for (size_t i = 0; i < live.size(); ++i)
+    {
+        const Block& block = blocks[ranges[live[i]]];
+        packed[i] = roundUp(cursor, block.alignment);
+        cursor = packed[i] + block.size;
+        liveBytes += block.size;
+        moves = moves || packed[i] != block.offset;
+    }
+
+    if (moves)
+    {
+        // Source and destination overlap within one buffer, which
+        // glCopyBufferSubData does not allow: go through a scratch buffer
+        GlBuffer scratch = GlBuffer::create();
+        glBindBuffer(GL_COPY_WRITE_BUFFER, scratch.get());
+        glBufferData(GL_COPY_WRITE_BUFFER, (GLsizeiptr)liveBytes, nullptr, GL_STREAM_COPY);
+        glBindBuffer(GL_COPY_READ_BUFFER, storage.get());
+
+        std::uint32_t scratchOffset = 0;
+        for (Id id : live)
+        {
+            const Block& block = blocks[ranges[id]];
+            glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, block.offset, scratchOffset, block.size);
+            scratchOffset += block.size;
+        }
+
+        glBindBuffer(GL_COPY_READ_BUFFER, scratch.get());
+        glBindBuffer(GL_COPY_WRITE_BUFFER, storage.get());
+
+        scratchOffset = 0;
+        for (size_t i = 0; i < live.size(); ++i)
+        {
+            const Block& block = blocks[ranges[live[i]]];
+            glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, scratchOffset, packed[i], block.size);
+            scratchOffset += block.size;
+        }
+
+        glBindBuffer(GL_COPY_READ_BUFFER, 0);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    }
+
+    // Rebuild the block list: live ranges at their new offsets, alignment
+    // gaps and the tail as free blocks
+    std::vector<Block> old;
+    old.swap(blocks);
+    clearBlocks();
+
+    int previous = -1;
+    std::uint32_t end = 0;
+
+    auto append = [&](std::uint32_t offset, std::uint32_t size) {
+        int index = newBlock();
+        blocks[index].offset = offset;
+        blocks[index].size = size;
+        blocks[index].prevPhysical = previous;
+        if (previous >= 0)
+            blocks[previous].nextPhysical = index;
+        previous = index;
+        end = offset + size;
+        return index;
+    };
+
+    for (size_t i = 0; i < live.size(); ++i)
+    {
+        const Block& from = old[ranges[live[i]]];
+        if (packed[i] > end)
+            insertFree(append(end, packed[i] - end));
+
+        int index = append(packed[i], from.size);
+        blocks[index].requested = from.requested;
+        blocks[index].alignment = from.alignment;
+        ranges[live[i]] = index;
+    }
+
+    if (end < capacity)
+        insertFree(append(end, capacity - end));
+
+    ++defragmentations;
+}
+
+// ===============================
+// Statistics
+// ===============================
+GpuArena::Stats GpuArena::stats() const
+{
+    Stats stats;
+    stats.capacity = capacity;
+    stats.used = usedBytes;
+    stats.free = freeBytes;
+    stats.allocations = liveRanges;
+    stats.defragmentations = defragmentations;
+
+    for (const Block& block : blocks)
+    {
+        if (!block.isFree)
+            continue;
+
+        stats.largestFree = std::max<size_t>(stats.largestFree, block.size);
+        ++stats.freeBlocks;
+    }
+
+    return stats;
+}
+
+void GpuArena::print(std::ostream& out, const char* name) const
+{
+    Stats s = stats();
+
+    char line[256];
+    std::snprintf(line, sizeof(line), "Arena %s: %zu / %zu bytes used in %zu ranges, %zu free blocks (largest %zu), fragmentation %.3f, %llu defragmentations\n",
+        name, s.used, s.capacity, s.allocations, s.freeBlocks, s.largestFree, s.fragmentation(), s.defragmentations);
+    out << line;
+}
@@ -0,0 +1,162 @@
+#include <glad/glad.h>
+
+#include <renderer/gpu_profiler.h>
+
+#include <cstdio>
+#include <utility>
+
+void GpuProfiler::init()
+{
+    initialized = true;
+    current = 0;
+}
+
+void GpuProfiler::destroy()
+{
+    // Every slot's queries go back in one glDeleteQueries
+    for (FrameSlot& slot : slots)
+    {
+        for (GlQuery& query : slot.queries)
+            queryPool.retire(std::move(query));
+        slot = FrameSlot();
+    }
+    queryPool.destroy();
+    initialized = false;
+}
+
+// ===============================
+// Frames
+// ===============================
+void GpuProfiler::beginFrame()
+{
+    if (!initialized)
+        return;
+
+    // This slot was last used LATENCY frames ago; harvest it before reuse
+    FrameSlot& slot = slots[current];
+    if (slot.pending)
+        collect(slot);
+
+    slot.usedQueries = 0;
+    slot.records.clear();
+    openScopes.clear();
+}
+
+void GpuProfiler::endFrame()
+{
+    if (!initialized)
+        return;
+
+    // Close anything left open so every record has both timestamps
+    while (!openScopes.empty())
+        endScope();
+
+    slots[current].pending = !slots[current].records.empty();
+    current = (current + 1) % LATENCY;
+}
+
+void GpuProfiler::finish()
+{
+    if (!initialized)
+        return;
+
+    // Oldest first; GL_QUERY_RESULT waits for the GPU
+    for (int i = 0; i < LATENCY; ++i)
+    {
+        FrameSlot& slot = slots[(current + i) % LATENCY];
+        if (slot.pending)
+            collect(slot, true);
+    }
+}
+
+void GpuProfiler::collect(FrameSlot& slot, bool wait)
+{
+    slot.pending = false;
+
+    // Queries complete in order, so the last one answers for all of them
+    GLint available = 0;
+    if (!wait)
+        glGetQueryObjectiv(slot.queries[slot.usedQueries - 1].get(), GL_QUERY_RESULT_AVAILABLE, &available);
+    if (!wait && !available)
+    {
+        ++dropped;
+        return;
+    }
+
+    for (const Record& record : slot.records)
+    {
+        GLuint64 begin = 0, end = 0;
+        glGetQueryObjectui64v(slot.queries[record.beginQuery].get(), GL_QUERY_RESULT, &begin);
+        glGetQueryObjectui64v(slot.queries[record.endQuery].get(), GL_QUERY_RESULT, &end);
+
+        ScopeStats& scope = stats[record.scope];
+        scope.totalMs += (double)(end - begin) / 1.0e6;
+        ++scope.samples;
+    }
+}
+
+// ===============================
+// Scopes
+// ===============================
+int GpuProfiler::scopeIndex(const char* name)
+{
+    for (size_t i = 0; i < stats.size(); ++i)
+    {
+        if (stats[i].name == name)
+            return (int)i;
+    }
+
+    ScopeStats scope;
+    scope.name = name;
+    stats.push_back(scope);
+    return (int)stats.size() - 1;
+}
+
+int GpuProfiler::timestamp(FrameSlot& slot)
+{
+    if (slot.usedQueries == (int)slot.queries.size())
+        slot.queries.push_back(queryPool.acquire());
+
+    int index = slot.usedQueries++;
+    glQueryCounter(slot.queries[index].get(), GL_TIMESTAMP);
+    return index;
+}
+
+void GpuProfiler::beginScope(const char* name)
+{
+    if (!initialized)
+        return;
+
+    FrameSlot& slot = slots[current];
+
+    Record record;
+    record.scope = scopeIndex(name);
+    record.beginQuery = timestamp(slot);
+    record.endQuery = -1;
+
+    slot.records.push_back(record);
+    openScopes.push_back((int)slot.records.size() - 1);
+}
+
+void GpuProfiler::endScope()
+{
+    if (!initialized || openScopes.empty())
+        return;
+
+    FrameSlot& slot = slots[current];
+    slot.records[openScopes.back()].endQuery = timestamp(slot);
+    openScopes.pop_back();
+}
+
+void GpuProfiler::print(std::ostream& out) const
+{
+    char line[128];
+    out << "GPU scopes (" << dropped << " frames dropped):\n";
+
+    for (const ScopeStats& scope : stats)
+    {
+        std::snprintf(line, sizeof(line), "  %-12s %9.4f ms  (%llu samples)\n",
+            scope.name.c_str(), scope.averageMs(), scope.samples);
+        out << line;
+    }
+}
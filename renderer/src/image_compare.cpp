@@ -0,0 +1,244 @@
+#include <renderer/image_compare.h>
+#include <renderer/image_io.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <iostream>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define RENDERER_COMPARE_SSE2 1
+#include <emmintrin.h>
+#endif
+
+// SSIM block size and the usual stabilizing constants for 8-bit data
+static const int SSIM_BLOCK = 8;
+static const double SSIM_C1 = (0.01 * 255.0) * (0.01 * 255.0);
+static const double SSIM_C2 = (0.03 * 255.0) * (0.03 * 255.0);
+
+// ===============================
+// Per-pixel tolerance
+// ===============================
+static void countBadPixels(const unsigned char* image, const unsigned char* reference, size_t pixelCount, int tolerance,
+    ImageDiff& diff)
+{
+    size_t bytes = pixelCount * 4;
+    size_t i = 0;
+    int maxDifference = 0;
+
+#if defined(RENDERER_COMPARE_SSE2)
+    // 4 pixels per step: |a - b| per byte from two saturating subtracts,
+    // then a pixel is good when its whole 32-bit lane is within tolerance
+    static const int goodLanes[16] = { 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4 };
+
+    const __m128i limit = _mm_set1_epi8((char)tolerance);
+    const __m128i zero = _mm_setzero_si128();
+    __m128i maxBytes = zero;
+
+    for (; i + 16 <= bytes; i += 16)
+    {
+        __m128i a = _mm_loadu_si128((const __m128i*)(image + i));
+        __m128i b = _mm_loadu_si128((const __m128i*)(reference + i));
+        __m128i difference = _mm_or_si128(_mm_subs_epu8(a, b), _mm_subs_epu8(b, a));
+        maxBytes = _mm_max_epu8(maxBytes, difference);
+
+        __m128i good = _mm_cmpeq_epi32(_mm_subs_epu8(difference, limit), zero);
+        diff.badPixels += 4 - goodLanes[_mm_movemask_ps(_mm_castsi128_ps(good))];
+    }
+
+    alignas(16) unsigned char lanes[16];
+    _mm_store_si128((__m128i*)lanes, maxBytes);
+    for (unsigned char lane : lanes)
+    {
+        if (lane > maxDifference)
+            maxDifference = lane;
+    }
+#endif
+
+    // Scalar for the tail (or everything without SSE2)
+    for (; i < bytes; i += 4)
+    {
+        int worst = 0;
+        for (int c = 0; c < 4; ++c)
+        {
+            int d = (int)image[i + c] - (int)reference[i + c];
+            d = d < 0 ? -d : d;
+            if (d > worst)
+                worst = d;
+        }
+
+        if (worst > tolerance)
+            ++diff.badPixels;
+        if (worst > maxDifference)
+            maxDifference = worst;
+    }
+
+    diff.maxDifference = maxDifference;
+}
+
+// ===============================
+// Perceptual metric (SSIM)
+// ===============================
+// Every whole 8x8 block (edge remainders are left out), for R, G and B
+// separately so a change of hue at equal brightness still counts. Returns
+// the lowest block SSIM of any channel.
+static double worstBlockSsim(const unsigned char* image, const unsigned char* reference, int width, int height)
+{
+    int blocksX = width / SSIM_BLOCK;
+    int blocksY = height / SSIM_BLOCK;
+    const double n = SSIM_BLOCK * SSIM_BLOCK;
+    double worst = 1.0;
+
+    for (int c = 0; c < 3; ++c)
+    {
+        for (int by = 0; by < blocksY; ++by)
+        {
+            for (int bx = 0; bx < blocksX; ++bx)
+            {
+                double sumA = 0, sumB = 0, sumAA = 0, sumBB = 0, sumAB = 0;
+
+                for (int y = by * SSIM_BLOCK; y < (by + 1) * SSIM_BLOCK; ++y)
+                {
+                    size_t row = (size_t)y * (size_t)width;
+                    for (int x = bx * SSIM_BLOCK; x < (bx + 1) * SSIM_BLOCK; ++x)
+                    {
+                        double a = image[(row + (size_t)x) * 4 + (size_t)c];
+                        double b = reference[(row + (size_t)x) * 4 + (size_t)c];
+                        sumA += a;
+                        sumB += b;
+                        sumAA += a * a;
+                        sumBB += b * b;
+                        sumAB += a * b;
+                    }
+                }
+
+                double meanA = sumA / n;
+                double meanB = sumB / n;
+                double varA = sumAA / n - meanA * meanA;
+                double varB = sumBB / n - meanB * meanB;
+                double covariance = sumAB / n - meanA * meanB;
+
+                double ssim = ((2.0 * meanA * meanB + SSIM_C1) * (2.0 * covariance + SSIM_C2))
+                    / ((meanA * meanA + meanB * meanB + SSIM_C1) * (varA + varB + SSIM_C2));
+                if (ssim < worst)
+                    worst = ssim;
+            }
+        }
+    }
+
+    return worst;
+}
+
+ImageDiff compareImages(const unsigned char* image, const unsigned char* reference, int width, int height,
+    int tolerance, double maxBadFraction, double minSsim)
+{
+    ImageDiff diff;
+    size_t pixelCount = (size_t)width * (size_t)height;
+    countBadPixels(image, reference, pixelCount, tolerance, diff);
+
+    // Exact enough already: skip the slower metric
+    if (diff.badPixels == 0)
+        return diff;
+
+    diff.ssim = worstBlockSsim(image, reference, width, height);
+    diff.matches = (double)diff.badPixels <= maxBadFraction * (double)pixelCount && diff.ssim >= minSsim;
+    return diff;
+}
+
+std::vector<unsigned char> diffHeatmap(const unsigned char* image, const unsigned char* reference, int width, int height,
+    int tolerance)
+{
+    size_t pixelCount = (size_t)width * (size_t)height;
+    std::vector<unsigned char> heatmap(pixelCount * 4);
+
+    for (size_t i = 0; i < pixelCount; ++i)
+    {
+        const unsigned char* a = image + i * 4;
+        const unsigned char* b = reference + i * 4;
+        unsigned char* out = &heatmap[i * 4];
+
+        int worst = 0;
+        for (int c = 0; c < 4; ++c)
+        {
+            int d = (int)a[c] - (int)b[c];
+            d = d < 0 ? -d : d;
+            if (d > worst)
+                worst = d;
+        }
+
+        if (worst <= tolerance)
+        {
+            // Dimmed reference, for orientation
+            unsigned char gray = (unsigned char)((b[0] + b[1] + b[2]) / 12);
+            out[0] = out[1] = out[2] = gray;
+        }
+        else
+        {
+            // 0 -> 1 past the tolerance: blue -> red -> yellow
+            double t = tolerance < 255 ? (double)(worst - tolerance) / (double)(255 - tolerance) : 1.0;
+            if (t < 0.5)
+            {
+                out[0] = (unsigned char)(510.0 * t);
+                out[1] = 0;
+                out[2] = (unsigned char)(255.0 - 510.0 * t);
+            }
+            else
+            {
+                out[0] = 255;
+                out[1] = (unsigned char)(510.0 * (t - 0.5));
+                out[2] = 0;
+            }
+        }
+        out[3] = 255;
+    }
+
+    return heatmap;
+}
+
+// ===============================
+// --compare
+// ===============================
+bool checkReferenceImage(const RenderOptions& options, const unsigned char* rgba, int width, int height, bool flipVertically)
+{
+    int referenceWidth = 0;
+    int referenceHeight = 0;
+    std::vector<unsigned char> reference;
+    if (!readPng(options.compareReference, referenceWidth, referenceHeight, reference))
+        return false;
+
+    if (referenceWidth != width || referenceHeight != height)
+    {
+        std::cout << "Reference " << options.compareReference << " is " << referenceWidth << "x" << referenceHeight
+                  << ", frame is " << width << "x" << height << "\n";
+        return false;
+    }
+
+    // Same row order as the PNG
+    std::vector<unsigned char> flipped;
+    if (flipVertically)
+    {
+        size_t rowBytes = (size_t)width * 4;
+        flipped.resize(rowBytes * (size_t)height);
+        for (int y = 0; y < height; ++y)
+            std::copy(rgba + (size_t)(height - 1 - y) * rowBytes, rgba + (size_t)(height - y) * rowBytes, flipped.begin() + (std::ptrdiff_t)((size_t)y * rowBytes));
+        rgba = flipped.data();
+    }
+
+    int tolerance = (int)options.compareTolerance;
+    ImageDiff diff = compareImages(rgba, reference.data(), width, height, tolerance, options.compareMaxBad, options.compareMinSsim);
+
+    char line[512];
+    std::snprintf(line, sizeof(line), "Reference %s: %s (%llu pixels over tolerance %d, max difference %d, worst block SSIM %.5f)\n",
+        options.compareReference.c_str(), diff.matches ? "match" : "MISMATCH", diff.badPixels, tolerance, diff.maxDifference, diff.ssim);
+    std::cout << line;
+
+    if (!diff.matches)
+    {
+        std::string diffPath = options.compareDiffPath.empty() ? "diff.png" : options.compareDiffPath;
+        std::vector<unsigned char> heatmap = diffHeatmap(rgba, reference.data(), width, height, tolerance);
+        if (writePng(diffPath, width, height, heatmap.data(), false))
+            std::cout << "Difference heatmap written to " << diffPath << "\n";
+    }
+
+    return diff.matches;
+}
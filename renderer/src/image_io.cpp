@@ -0,0 +1,525 @@
+#include <renderer/image_io.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <vector>
+
+// ===============================
+// Checksums
+// ===============================
+static std::array<std::uint32_t, 256> makeCrcTable()
+{
+    std::array<std::uint32_t, 256> table;
+    for (std::uint32_t n = 0; n < 256; ++n)
+    {
+        std::uint32_t c = n;
+        for (int k = 0; k < 8; ++k)
+            c = (c & 1) ? 0xedb88320u ^ (c >> 1) : c >> 1;
+        table[n] = c;
+    }
+    return table;
+}
+
+static std::uint32_t crc32(std::uint32_t crc, const unsigned char* data, size_t size)
+{
+    // Function-local static: built once, safe to reach from several threads
+    static const std::array<std::uint32_t, 256> table = makeCrcTable();
+
+    crc = ~crc;
+    for (size_t i = 0; i < size; ++i)
+        crc = table[(crc ^ data[i]) & 0xff] ^ (crc >> 8);
+    return ~crc;
+}
+
+static std::uint32_t adler32(const unsigned char* data, size_t size)
+{
+    std::uint32_t a = 1, b = 0;
+    for (size_t i = 0; i < size; ++i)
+    {
+        a = (a + data[i]) % 65521u;
+        b = (b + a) % 65521u;
+    }
+    return (b << 16) | a;
+}
+
+// ===============================
+// PNG writer
+// ===============================
+static void putU32(std::vector<unsigned char>& out, std::uint32_t value)
+{
+    out.push_back((unsigned char)(value >> 24));
+    out.push_back((unsigned char)(value >> 16));
+    out.push_back((unsigned char)(value >> 8));
+    out.push_back((unsigned char)value);
+}
+
+static void writeChunk(std::ofstream& file, const char* type, const std::vector<unsigned char>& data)
+{
+    std::vector<unsigned char> chunk;
+    putU32(chunk, (std::uint32_t)data.size());
+    chunk.insert(chunk.end(), type, type + 4);
+    chunk.insert(chunk.end(), data.begin(), data.end());
+    putU32(chunk, crc32(0, chunk.data() + 4, chunk.size() - 4));
+
+    file.write((const char*)chunk.data(), (std::streamsize)chunk.size());
+}
+
+bool writePng(const std::string& path, int width, int height, const unsigned char* rgba, bool flipVertically)
+{
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file)
+    {
+        std::cout << "Failed to open " << path << " for writing\n";
+        return false;
+    }
+
+    static const unsigned char signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n' };
+    file.write((const char*)signature, sizeof(signature));
+
+    std::vector<unsigned char> header;
+    putU32(header, (std::uint32_t)width);
+    putU32(header, (std::uint32_t)height);
+    header.push_back(8); // bit depth
+    header.push_back(6); // RGBA
+    header.push_back(0); // deflate
+    header.push_back(0); // adaptive filtering
+    header.push_back(0); // no interlace
+    writeChunk(file, "IHDR", header);
+
+    // Raw scanlines, each prefixed with filter type 0
+    size_t rowBytes = (size_t)width * 4;
+    std::vector<unsigned char> raw;
+    raw.reserve((rowBytes + 1) * (size_t)height);
+    for (int y = 0; y < height; ++y)
+    {
+        int srcRow = flipVertically ? height - 1 - y : y;
+        const unsigned char* row = rgba + (size_t)srcRow * rowBytes;
+        raw.push_back(0);
+        raw.insert(raw.end(), row, row + rowBytes);
+    }
+
+    // zlib stream made of stored (uncompressed) deflate blocks
+    std::vector<unsigned char> zlib;
+    zlib.push_back(0x78);
+    zlib.push_back(0x01);
+
+    size_t offset = 0;
+    do
+    {
+        size_t blockSize = raw.size() - offset;
+        if (blockSize > 65535)
+            blockSize = 65535;
+        bool last = offset + blockSize == raw.size();
+
+        zlib.push_back(last ? 1 : 0);
+        zlib.push_back((unsigned char)(blockSize & 0xff));
+        zlib.push_back((unsigned char)(blockSize >> 8));
+        zlib.push_back((unsigned char)(~blockSize & 0xff));
+        zlib.push_back((unsigned char)((~blockSize >> 8) & 0xff));
+        zlib.insert(zlib.end(), raw.begin() + (std::ptrdiff_t)offset, raw.begin() + (std::ptrdiff_t)(offset + blockSize));
+
+        offset += blockSize;
+    } while (offset < raw.size());
+
+    putU32(zlib, adler32(raw.data(), raw.size()));
+    writeChunk(file, "IDAT", zlib);
+    writeChunk(file, "IEND", std::vector<unsigned char>());
+
+    return (bool)file;
+}
+
+// ===============================
+// Inflate (RFC 1951)
+// ===============================
+// Canonical Huffman decoding one bit at a time, as in zlib's puff.c:
+// slow next to zlib, but reference images are read once per run
+namespace
+{
+struct BitReader
+{
+    const unsigned char* data;
+    size_t size;
+    size_t pos = 0;
+    std::uint32_t buffer = 0;
+    int count = 0;
+    bool overrun = false;
+
+    int bits(int n)
+    {
+        while (count < n)
+        {
+            std::uint32_t byte = 0;
+            if (pos < size)
+                byte = data[pos++];
+            else
+                overrun = true;
+            buffer |= byte << count;
+            count += 8;
+        }
+
+        int value = (int)(buffer & ((1u << n) - 1));
+        buffer >>= n;
+        count -= n;
+        return value;
+    }
+
+    // Drops what is left of the current byte (only whole bytes are loaded)
+    void alignToByte()
+    {
+        buffer = 0;
+        count = 0;
+    }
+};
+
+struct Huffman
+{
+    std::uint16_t counts[16];   // codes per length
+    std::uint16_t symbols[288]; // ordered by code
+};
+}
+
+static void buildHuffman(Huffman& huffman, const std::uint8_t* lengths, int symbolCount)
+{
+    std::uint16_t offsets[16];
+
+    for (std::uint16_t& count : huffman.counts)
+        count = 0;
+    for (int i = 0; i < symbolCount; ++i)
+        ++huffman.counts[lengths[i]];
+    huffman.counts[0] = 0;
+
+    offsets[1] = 0;
+    for (int length = 1; length < 15; ++length)
+        offsets[length + 1] = (std::uint16_t)(offsets[length] + huffman.counts[length]);
+
+    for (int i = 0; i < symbolCount; ++i)
+    {
+        if (lengths[i])
+            huffman.symbols[offsets[lengths[i]]++] = (std::uint16_t)i;
+    }
+}
+
+static int decodeSymbol(BitReader& in, const Huffman& huffman)
+{
+    int code = 0;
+    int first = 0;
+    int index = 0;
+
+    for (int length = 1; length < 16; ++length)
+    {
+        code |= in.bits(1);
+        int count = huffman.counts[length];
+        if (code - count < first)
+            return huffman.symbols[index + (code - first)];
+
+        index += count;
+        first = (first + count) << 1;
+        code <<= 1;
+    }
+    return -1;
+}
+
+static bool inflateCodes(BitReader& in, std::vector<unsigned char>& out, size_t limit, const Huffman& lengthCodes, const Huffman& distanceCodes)
+{
+    static const std::uint16_t lengthBase[29] = { 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+    static const std::uint8_t lengthExtra[29] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+    static const std::uint16_t distanceBase[30] = { 1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+    static const std::uint8_t distanceExtra[30] = { 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+
+    for (;;)
+    {
+        int symbol = decodeSymbol(in, lengthCodes);
+        if (symbol < 0 || in.overrun)
+            return false;
+        if (symbol == 256)
+            return true;
+
+        if (symbol < 256)
+        {
+            if (out.size() >= limit)
+                return false;
+            out.push_back((unsigned char)symbol);
+            continue;
+        }
+
+        symbol -= 257;
+        if (symbol >= 29)
+            return false;
+        size_t length = lengthBase[symbol] + (size_t)in.bits(lengthExtra[symbol]);
+
+        int distanceSymbol = decodeSymbol(in, distanceCodes);
+        if (distanceSymbol < 0 || distanceSymbol >= 30)
+            return false;
+        size_t distance = distanceBase[distanceSymbol] + (size_t)in.bits(distanceExtra[distanceSymbol]);
+
+        if (distance > out.size() || out.size() + length > limit)
+            return false;
+
+        // Byte by byte: the source may overlap what is being written
+        size_t from = out.size() - distance;
+        for (size_t i = 0; i < length; ++i)
+            out.push_back(out[from + i]);
+    }
+}
+
+// `limit` bounds the output, so a corrupt stream cannot balloon
+static bool inflateStream(const unsigned char* data, size_t size, std::vector<unsigned char>& out, size_t limit)
+{
+    static const std::uint8_t codeLengthOrder[19] = { 16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+
+    BitReader in = { data, size };
+    Huffman lengthCodes;
+    Huffman distanceCodes;
+
+    int last;
+    do
+    {
+        last = in.bits(1);
+        int type = in.bits(2);
+
+        if (type == 0)
+        {
+            // Stored
+            in.alignToByte();
+            if (in.pos + 4 > size)
+                return false;
+
+            size_t length = data[in.pos] | (size_t)data[in.pos + 1] << 8;
+            size_t inverted = data[in.pos + 2] | (size_t)data[in.pos + 3] << 8;
+            in.pos += 4;
+            if (length != (~inverted & 0xffff) || in.pos + length > size || out.size() + length > limit)
+                return false;
+
+            out.insert(out.end(), data + in.pos, data + in.pos + length);
+            in.pos += length;
+        }
+        else if (type == 1)
+        {
+            // Fixed codes
+            std::uint8_t lengths[288 + 30];
+            for (int i = 0; i < 288; ++i)
+                lengths[i] = i < 144 ? 8 : i < 256 ? 9 : i < 280 ? 7 : 8;
+            for (int i = 0; i < 30; ++i)
+                lengths[288 + i] = 5;
+
+            buildHuffman(lengthCodes, lengths, 288);
+            buildHuffman(distanceCodes, lengths + 288, 30);
+
+            if (!inflateCodes(in, out, limit, lengthCodes, distanceCodes))
+                return false;
+        }
+        else if (type == 2)
+        {
+            // Dynamic codes, themselves Huffman coded
+            int lengthCount = in.bits(5) + 257;
+            int distanceCount = in.bits(5) + 1;
+            int codeLengthCount = in.bits(4) + 4;
+            if (lengthCount > 286 || distanceCount > 30)
+                return false;
+
+            std::uint8_t lengths[288 + 30] = {};
+            for (int i = 0; i < codeLengthCount; ++i)
+                lengths[codeLengthOrder[i]] = (std::uint8_t)in.bits(3);
+
+            Huffman codeLengthCodes;
+            buildHuffman(codeLengthCodes, lengths, 19);
+
+            int total = lengthCount + distanceCount;
+            int index = 0;
+            while (index < total)
+            {
+                int symbol = decodeSymbol(in, codeLengthCodes);
+                if (symbol < 0 || in.overrun)
+                    return false;
+
+                if (symbol < 16)
+                {
+                    lengths[index++] = (std::uint8_t)symbol;
+                    continue;
+                }
+
+                std::uint8_t value = 0;
+                int repeat;
+                if (symbol == 16)
+                {
+                    if (index == 0)
+                        return false;
+                    value = lengths[index - 1];
+                    repeat = 3 + in.bits(2);
+                }
+                else if (symbol == 17)
+                {
+                    repeat = 3 + in.bits(3);
+                }
+                else
+                {
+                    repeat = 11 + in.bits(7);
+                }
+
+                if (index + repeat > total)
+                    return false;
+                while (repeat--)
+                    lengths[index++] = value;
+            }
+
+            buildHuffman(lengthCodes, lengths, lengthCount);
+            buildHuffman(distanceCodes, lengths + lengthCount, distanceCount);
+
+            if (!inflateCodes(in, out, limit, lengthCodes, distanceCodes))
+                return false;
+        }
+        else
+        {
+            return false;
+        }
+    } while (!last);
+
+    return !in.overrun;
+}
+
+// ===============================
+// PNG reader
+// ===============================
+static std::uint32_t getU32(const unsigned char* data)
+{
+    return (std::uint32_t)data[0] << 24 | (std::uint32_t)data[1] << 16 | (std::uint32_t)data[2] << 8 | data[3];
+}
+
+static int paeth(int a, int b, int c)
+{
+    int p = a + b - c;
+    int pa = p > a ? p - a : a - p;
+    int pb = p > b ? p - b : b - p;
+    int pc = p > c ? p - c : c - p;
+    if (pa <= pb && pa <= pc)
+        return a;
+    return pb <= pc ? b : c;
+}
+
+bool readPng(const std::string& path, int& width, int& height, std::vector<unsigned char>& rgba)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+    {
+        std::cout << "Failed to open " << path << "\n";
+        return false;
+    }
+
+    std::vector<unsigned char> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    static const unsigned char signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n' };
+    if (bytes.size() < 8 || !std::equal(signature, signature + 8, bytes.begin()))
+    {
+        std::cout << path << " is not a PNG\n";
+        return false;
+    }
+
+    // Chunks: only IHDR and IDAT matter here
+    int colorType = -1;
+    std::uint32_t pngWidth = 0, pngHeight = 0;
+    std::vector<unsigned char> zlib;
+
+    size_t pos = 8;
+    while (pos + 12 <= bytes.size())
+    {
+        std::uint32_t length = getU32(&bytes[pos]);
+        const unsigned char* type = &bytes[pos + 4];
+        const unsigned char* data = &bytes[pos + 8];
+        if (length > bytes.size() - pos - 12)
+            break;
+
+        if (std::equal(type, type + 4, "IHDR") && length >= 13)
+        {
+            pngWidth = getU32(data);
+            pngHeight = getU32(data + 4);
+            colorType = data[9];
+
+            // 8-bit RGB / RGBA, not interlaced
+            if (data[8] != 8 || (colorType != 2 && colorType != 6) || data[12] != 0)
+            {
+                std::cout << path << ": only 8-bit RGB/RGBA non-interlaced PNGs are supported\n";
+                return false;
+            }
+        }
+        else if (std::equal(type, type + 4, "IDAT"))
+        {
+            zlib.insert(zlib.end(), data, data + length);
+        }
+        else if (std::equal(type, type + 4, "IEND"))
+        {
+            break;
+        }
+
+        pos += 12 + (size_t)length;
+    }
+
+    if (colorType < 0 || pngWidth == 0 || pngHeight == 0 || pngWidth > 16384 || pngHeight > 16384 || zlib.size() < 6)
+    {
+        std::cout << path << ": missing or invalid image data\n";
+        return false;
+    }
+
+    size_t channels = colorType == 6 ? 4 : 3;
+    size_t rowBytes = (size_t)pngWidth * channels;
+    size_t rawSize = (rowBytes + 1) * pngHeight;
+
+    // 2-byte zlib header, deflate stream, 4-byte Adler-32 (not checked)
+    std::vector<unsigned char> raw;
+    raw.reserve(rawSize);
+    if ((zlib[0] & 0x0f) != 8 || !inflateStream(zlib.data() + 2, zlib.size() - 2, raw, rawSize) || raw.size() != rawSize)
+    {
+        std::cout << path << ": corrupt image data\n";
+        return false;
+    }
+
+    // Undo the per-row filters in place
+    for (size_t y = 0; y < pngHeight; ++y)
+    {
+        unsigned char filter = raw[y * (rowBytes + 1)];
+        unsigned char* row = &raw[y * (rowBytes + 1) + 1];
+        const unsigned char* above = y ? row - (rowBytes + 1) : nullptr;
+
+        for (size_t x = 0; x < rowBytes; ++x)
+        {
+            int a = x >= channels ? row[x - channels] : 0;
+            int b = above ? above[x] : 0;
+            int c = above && x >= channels ? above[x - channels] : 0;
+
+            switch (filter)
+            {
+            case 0: break;
+            case 1: row[x] = (unsigned char)(row[x] + a); break;
+            case 2: row[x] = (unsigned char)(row[x] + b); break;
+            case 3: row[x] = (unsigned char)(row[x] + ((a + b) >> 1)); break;
+            case 4: row[x] = (unsigned char)(row[x] + paeth(a, b, c)); break;
+            default:
+                std::cout << path << ": unknown row filter " << (int)filter << "\n";
+                return false;
+            }
+        }
+    }
+
+    width = (int)pngWidth;
+    height = (int)pngHeight;
+    rgba.resize((size_t)pngWidth * pngHeight * 4);
+
+    for (size_t y = 0; y < pngHeight; ++y)
+    {
+        const unsigned char* row = &raw[y * (rowBytes + 1) + 1];
+        unsigned char* target = &rgba[y * pngWidth * 4];
+        for (size_t x = 0; x < pngWidth; ++x)
+        {
+            target[x * 4 + 0] = row[x * channels + 0];
+            target[x * 4 + 1] = row[x * channels + 1];
+            target[x * 4 + 2] = row[x * channels + 2];
+            target[x * 4 + 3] = channels == 4 ? row[x * channels + 3] : 255;
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,138 @@
+#include <glad/glad.h>
+
+#include <renderer/index_buffer.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+// Vertices one 16-bit chunk can address
+static const size_t SHORT_RANGE = 65536;
+
+unsigned int indexTypeFor(size_t vertexCount)
+{
+    if (vertexCount <= 256)
+        return GL_UNSIGNED_BYTE;
+    if (vertexCount <= SHORT_RANGE)
+        return GL_UNSIGNED_SHORT;
+    return GL_UNSIGNED_INT;
+}
+
+size_t indexTypeSize(unsigned int type)
+{
+    switch (type)
+    {
+    case GL_UNSIGNED_BYTE:
+        return 1;
+    case GL_UNSIGNED_SHORT:
+        return 2;
+    default:
+        return 4;
+    }
+}
+
+void packIndices(const unsigned int* indices, size_t count, unsigned int base, unsigned int type, std::vector<unsigned char>& out)
+{
+    size_t start = out.size();
+    out.resize(start + count * indexTypeSize(type));
+    unsigned char* dst = out.data() + start;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        unsigned int value = indices[i] - base;
+
+        if (type == GL_UNSIGNED_BYTE)
+        {
+            dst[i] = (unsigned char)value;
+        }
+        else if (type == GL_UNSIGNED_SHORT)
+        {
+            std::uint16_t narrow = (std::uint16_t)value;
+            std::memcpy(dst + i * 2, &narrow, 2);
+        }
+        else
+        {
+            std::memcpy(dst + i * 4, &value, 4);
+        }
+    }
+}
+
+// ===============================
+// Chunking
+// ===============================
+// Greedy: extend the current chunk triangle by triangle until its vertex
+// span would pass SHORT_RANGE. Empty if some triangle spans too far alone.
+static std::vector<IndexChunk> splitChunks(const unsigned int* indices, size_t indexCount)
+{
+    std::vector<IndexChunk> chunks;
+    IndexChunk chunk = {0, 0, 0};
+    unsigned int low = 0, high = 0;
+
+    for (size_t i = 0; i < indexCount; i += 3)
+    {
+        size_t corners = std::min<size_t>(3, indexCount - i);
+        unsigned int triLow = indices[i], triHigh = indices[i];
+        for (size_t c = 1; c < corners; ++c)
+        {
+            triLow = std::min(triLow, indices[i + c]);
+            triHigh = std::max(triHigh, indices[i + c]);
+        }
+
+        // A single triangle no chunk can hold
+        if (triHigh - triLow >= SHORT_RANGE)
+            return {};
+
+        bool fits = chunk.indexCount > 0 && (size_t)std::max(high, triHigh) - std::min(low, triLow) < SHORT_RANGE;
+        if (!fits && chunk.indexCount > 0)
+        {
+            chunk.baseVertex = (int)low;
+            chunks.push_back(chunk);
+            chunk = {i, 0, 0};
+        }
+
+        if (chunk.indexCount == 0)
+        {
+            low = triLow;
+            high = triHigh;
+        }
+        else
+        {
+            low = std::min(low, triLow);
+            high = std::max(high, triHigh);
+        }
+        chunk.indexCount += corners;
+    }
+
+    if (chunk.indexCount > 0)
+    {
+        chunk.baseVertex = (int)low;
+        chunks.push_back(chunk);
+    }
+    return chunks;
+}
+
+IndexBuffer buildIndexBuffer(const unsigned int* indices, size_t indexCount, size_t vertexCount, bool compact)
+{
+    IndexBuffer buffer;
+    buffer.indexCount = indexCount;
+    buffer.type = compact ? indexTypeFor(vertexCount) : GL_UNSIGNED_INT;
+
+    if (buffer.type == GL_UNSIGNED_INT && compact)
+    {
+        std::vector<IndexChunk> chunks = splitChunks(indices, indexCount);
+        if (!chunks.empty() && chunks.size() * IndexBuffer::MIN_CHUNK_INDICES <= indexCount)
+        {
+            buffer.type = GL_UNSIGNED_SHORT;
+            buffer.indexSize = 2;
+            buffer.chunks = chunks;
+            for (const IndexChunk& chunk : chunks)
+                packIndices(indices + chunk.firstIndex, chunk.indexCount, (unsigned int)chunk.baseVertex, GL_UNSIGNED_SHORT, buffer.bytes);
+            return buffer;
+        }
+    }
+
+    buffer.indexSize = indexTypeSize(buffer.type);
+    buffer.chunks.push_back({0, indexCount, 0});
+    packIndices(indices, indexCount, 0, buffer.type, buffer.bytes);
+    return buffer;
+}
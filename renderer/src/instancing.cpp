@@ -0,0 +1,122 @@
+#include <glad/glad.h>
+
+#include <renderer/instancing.h>
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+// ===============================
+// Shaders
+// ===============================
+const char* instancedVertexShaderSource = R"(
+#version 330 core
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec4 aTransform;
+layout (location = 2) in vec4 aColor;
+
+out vec4 instanceColor;
+
+void main()
+{
+    gl_Position = vec4(aPos.xy * aTransform.zw + aTransform.xy, aPos.z, 1.0);
+    instanceColor = aColor;
+}
+)";
+
+const char* instancedFragmentShaderSource = R"(
+#version 330 core
+in vec4 instanceColor;
+out vec4 FragColor;
+
+void main()
+{
+    FragColor = instanceColor;
+}
+)";
+
+// ===============================
+// Grid layout
+// ===============================
+static float hashToUnit(std::uint32_t x)
+{
+    x ^= x >> 16;
+    x *= 0x7feb352du;
+    x ^= x >> 15;
+    x *= 0x846ca68bu;
+    x ^= x >> 16;
+    return (float)(x & 0xffffffu) / (float)0xffffffu;
+}
+
+std::vector<InstanceData> layoutInstanceGrid(size_t count)
+{
+    size_t columns = (size_t)std::ceil(std::sqrt((double)count));
+    if (columns == 0)
+        columns = 1;
+    size_t rows = (count + columns - 1) / columns;
+    if (rows == 0)
+        rows = 1;
+
+    // Meshes span [-0.5, 0.5]; leave a 20% gap between cells
+    float cellW = 2.0f / (float)columns;
+    float cellH = 2.0f / (float)rows;
+
+    std::vector<InstanceData> instances(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        size_t col = i % columns;
+        size_t row = i / columns;
+
+        InstanceData& data = instances[i];
+        data.transform[0] = -1.0f + cellW * ((float)col + 0.5f);
+        data.transform[1] = -1.0f + cellH * ((float)row + 0.5f);
+        data.transform[2] = cellW * 0.8f;
+        data.transform[3] = cellH * 0.8f;
+
+        // The samples' pink, with a little per-instance variation
+        float shade = 0.75f + 0.25f * hashToUnit((std::uint32_t)i);
+        data.color[0] = 1.0f * shade;
+        data.color[1] = 0.5f * shade;
+        data.color[2] = 0.6f * shade;
+        data.color[3] = 1.0f;
+    }
+
+    return instances;
+}
+
+// ===============================
+// Instance VBO
+// ===============================
+void InstanceBuffer::create(size_t count)
+{
+    instanceCount = count;
+    std::vector<InstanceData> instances = layoutInstanceGrid(count);
+
+    vbo = GlBuffer::create();
+    glBindBuffer(GL_ARRAY_BUFFER, vbo.get());
+    glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)(count * sizeof(InstanceData)), instances.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void InstanceBuffer::attach(unsigned int vao) const
+{
+    glBindVertexArray(vao);
+    glBindBuffer(GL_ARRAY_BUFFER, vbo.get());
+
+    glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeof(InstanceData), (void*)offsetof(InstanceData, transform));
+    glEnableVertexAttribArray(1);
+    glVertexAttribDivisor(1, 1);
+
+    glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, sizeof(InstanceData), (void*)offsetof(InstanceData, color));
+    glEnableVertexAttribArray(2);
+    glVertexAttribDivisor(2, 1);
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
+}
+
+void InstanceBuffer::destroy()
+{
+    vbo.reset();
+    instanceCount = 0;
+}
@@ -0,0 +1,206 @@
+#include <glad/glad.h>
+
+#include <renderer/gl_state_cache.h>
+#include <renderer/mesh.h>
+
+#include <cstring>
+
+static const GLsizei VERTEX_STRIDE = 3 * sizeof(float);
+
+void MeshBuffers::create(const MeshData& mesh, GeometryArenas* sharedArenas, bool compactIndices)
+{
+    data = mesh;
+
+    packedIndices = IndexBuffer();
+    if (mesh.indices)
+        packedIndices = buildIndexBuffer(mesh.indices, mesh.indexCount, mesh.vertexCount, compactIndices);
+
+    size_t vertexBytes = mesh.vertexCount * VERTEX_STRIDE;
+    size_t indexBytes = packedIndices.bytes.size();
+
+    if (sharedArenas && sharedArenas->vertices.valid() && (!mesh.indices || sharedArenas->indices.valid()))
+    {
+        // Stride alignment keeps offset / stride an exact base vertex
+        vertexRange = sharedArenas->vertices.allocate(vertexBytes, VERTEX_STRIDE);
+        if (mesh.indices && vertexRange != GpuArena::INVALID)
+            indexRange = sharedArenas->indices.allocate(indexBytes, packedIndices.indexSize);
+
+        if (vertexRange != GpuArena::INVALID && (!mesh.indices || indexRange != GpuArena::INVALID))
+        {
+            arenas = sharedArenas;
+            arenas->vertices.upload(vertexRange, mesh.positions, vertexBytes);
+            if (mesh.indices)
+                arenas->indices.upload(indexRange, packedIndices.bytes.data(), indexBytes);
+        }
+        else
+        {
+            // Arena full: this mesh gets its own buffers after all
+            sharedArenas->vertices.free(vertexRange);
+            vertexRange = GpuArena::INVALID;
+        }
+    }
+
+    vao = GlVertexArray::create();
+
+    // Bind the VAO first, then the buffers and the attribute layout it records
+    glBindVertexArray(vao.get());
+
+    if (arenas)
+    {
+        // Attribute offset 0: draws add the range's base vertex instead
+        glBindBuffer(GL_ARRAY_BUFFER, arenas->vertices.buffer());
+        if (mesh.indices)
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, arenas->indices.buffer());
+    }
+    else
+    {
+        vbo = GlBuffer::create();
+        glBindBuffer(GL_ARRAY_BUFFER, vbo.get());
+        glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)vertexBytes, mesh.positions, GL_STATIC_DRAW);
+
+        if (mesh.indices)
+        {
+            ebo = GlBuffer::create();
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo.get());
+            glBufferData(GL_ELEMENT_ARRAY_BUFFER, (GLsizeiptr)indexBytes, packedIndices.bytes.data(), GL_STATIC_DRAW);
+        }
+    }
+
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, VERTEX_STRIDE, (void*)0);
+    glEnableVertexAttribArray(0);
+
+    // The attribute keeps its VBO; the EBO binding is VAO state and must
+    // stay, so only the VAO is unbound after the array buffer
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
+}
+
+bool MeshBuffers::createStreaming(size_t regionBytes)
+{
+    if (!streamVertices.create(regionBytes) || (data.indices && !streamIndices.create(regionBytes)))
+    {
+        streamVertices.destroy();
+        streamIndices.destroy();
+        return false;
+    }
+
+    // Same layout, but the geometry is rewritten into a ring every frame
+    streamVao = GlVertexArray::create();
+    glBindVertexArray(streamVao.get());
+
+    glBindBuffer(GL_ARRAY_BUFFER, streamVertices.buffer());
+    if (data.indices)
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, streamIndices.buffer());
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, VERTEX_STRIDE, (void*)0);
+    glEnableVertexAttribArray(0);
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
+    return true;
+}
+
+void MeshBuffers::destroy()
+{
+    vao.reset();
+    streamVao.reset();
+    vbo.reset();
+    ebo.reset();
+
+    if (arenas)
+    {
+        arenas->vertices.free(vertexRange);
+        arenas->indices.free(indexRange);
+        arenas = nullptr;
+    }
+    vertexRange = indexRange = GpuArena::INVALID;
+
+    streamVertices.destroy();
+    streamIndices.destroy();
+}
+
+// ===============================
+// Draw submission
+// ===============================
+int MeshBuffers::baseVertex() const
+{
+    return arenas ? (int)(arenas->vertices.offset(vertexRange) / VERTEX_STRIDE) : 0;
+}
+
+size_t MeshBuffers::indexOffset() const
+{
+    return arenas ? arenas->indices.offset(indexRange) : 0;
+}
+
+void MeshBuffers::drawChunks(size_t firstByte, int firstVertex, size_t instanceCount) const
+{
+    for (const IndexChunk& chunk : packedIndices.chunks)
+    {
+        const void* first = (const void*)(firstByte + chunk.firstIndex * packedIndices.indexSize);
+
+        if (instanceCount > 0)
+            glDrawElementsInstancedBaseVertex(GL_TRIANGLES, (GLsizei)chunk.indexCount, packedIndices.type, first, (GLsizei)instanceCount, firstVertex + chunk.baseVertex);
+        else
+            glDrawElementsBaseVertex(GL_TRIANGLES, (GLsizei)chunk.indexCount, packedIndices.type, first, firstVertex + chunk.baseVertex);
+    }
+}
+
+void MeshBuffers::draw(GlStateCache& stateCache) const
+{
+    stateCache.bindVertexArray(vao.get());
+
+    if (data.indices)
+        drawChunks(indexOffset(), baseVertex(), 0);
+    else
+        glDrawArrays(GL_TRIANGLES, baseVertex(), (GLsizei)data.vertexCount);
+}
+
+void MeshBuffers::drawInstanced(GlStateCache& stateCache, size_t instanceCount) const
+{
+    stateCache.bindVertexArray(vao.get());
+
+    if (data.indices)
+        drawChunks(indexOffset(), baseVertex(), instanceCount);
+    else
+        glDrawArraysInstanced(GL_TRIANGLES, baseVertex(), (GLsizei)data.vertexCount, (GLsizei)instanceCount);
+}
+
+void MeshBuffers::drawStreamed(GlStateCache& stateCache)
+{
+    size_t vertexBytes = data.vertexCount * VERTEX_STRIDE;
+    size_t indexBytes = packedIndices.bytes.size();
+
+    streamVertices.beginFrame();
+    if (data.indices)
+        streamIndices.beginFrame();
+
+    StreamBuffer::Allocation v = streamVertices.allocate(vertexBytes, VERTEX_STRIDE);
+    StreamBuffer::Allocation i;
+    if (data.indices)
+        i = streamIndices.allocate(indexBytes, sizeof(unsigned int));
+
+    if (v.data && (!data.indices || i.data))
+    {
+        std::memcpy(v.data, data.positions, vertexBytes);
+        streamVertices.commit();
+
+        stateCache.bindVertexArray(streamVao.get());
+        GLint firstVertex = (GLint)(v.offset / VERTEX_STRIDE);
+
+        if (data.indices)
+        {
+            std::memcpy(i.data, packedIndices.bytes.data(), indexBytes);
+            streamIndices.commit();
+
+            // Indices stay 0-based; base vertex points them at this frame's copy
+            drawChunks(i.offset, firstVertex, 0);
+        }
+        else
+        {
+            glDrawArrays(GL_TRIANGLES, firstVertex, (GLsizei)data.vertexCount);
+        }
+    }
+
+    streamVertices.endFrame();
+    if (data.indices)
+        streamIndices.endFrame();
+}
@@ -0,0 +1,215 @@
+#include <glad/glad.h>
+
+#include <renderer/offscreen_context.h>
+
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <mutex>
+
+#if defined(__linux__) && !defined(RENDERER_DISABLE_EGL)
+#define RENDERER_HAVE_EGL 1
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#endif
+
+#ifdef RENDERER_HAVE_EGL
+
+// ===============================
+// Display selection
+// ===============================
+// EGL hands every caller the same display and eglTerminate() is not
+// reference counted, so contexts living on other threads would die with
+// the first one destroyed. Count users per display and terminate with
+// the last; the same lock serializes initialization (recursive: create()
+// cleans up through destroy() on failure).
+static std::recursive_mutex displayMutex;
+static std::map<EGLDisplay, int> displayUsers;
+
+static EGLDisplay openSurfacelessDisplay()
+{
+    const char* clientExts = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+    if (!clientExts || !std::strstr(clientExts, "EGL_MESA_platform_surfaceless"))
+        return EGL_NO_DISPLAY;
+
+    auto getPlatformDisplay = (PFNEGLGETPLATFORMDISPLAYEXTPROC)
+        eglGetProcAddress("eglGetPlatformDisplayEXT");
+    if (!getPlatformDisplay)
+        return EGL_NO_DISPLAY;
+
+    return getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+}
+
+bool OffscreenContext::create(int width, int height)
+{
+    fbWidth = width;
+    fbHeight = height;
+
+    std::lock_guard<std::recursive_mutex> lock(displayMutex);
+
+    bool surfaceless = true;
+    EGLDisplay eglDisplay = openSurfacelessDisplay();
+    EGLint major = 0, minor = 0;
+
+    if (eglDisplay == EGL_NO_DISPLAY || !eglInitialize(eglDisplay, &major, &minor))
+    {
+        surfaceless = false;
+        eglDisplay = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+        if (eglDisplay == EGL_NO_DISPLAY || !eglInitialize(eglDisplay, &major, &minor))
+        {
+            std::cout << "Failed to initialize EGL display\n";
+            return false;
+        }
+    }
+    display = eglDisplay;
+    ++displayUsers[eglDisplay];
+
+    if (!eglBindAPI(EGL_OPENGL_API))
+    {
+        std::cout << "EGL display does not support desktop OpenGL\n";
+        destroy();
+        return false;
+    }
+
+    const EGLint configAttribs[] =
+    {
+        EGL_SURFACE_TYPE, surfaceless ? 0 : EGL_PBUFFER_BIT,
+        EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+        EGL_RED_SIZE, 8,
+        EGL_GREEN_SIZE, 8,
+        EGL_BLUE_SIZE, 8,
+        EGL_ALPHA_SIZE, 8,
+        EGL_NONE
+    };
+
+    EGLConfig config = nullptr;
+    EGLint numConfigs = 0;
+    if (!eglChooseConfig(eglDisplay, configAttribs, &config, 1, &numConfigs) || numConfigs == 0)
+    {
+        std::cout << "No suitable EGL config\n";
+        destroy();
+        return false;
+    }
+
+    // Same version/profile the GLFW path asks for
+    const EGLint contextAttribs[] =
+    {
+        EGL_CONTEXT_MAJOR_VERSION, 3,
+        EGL_CONTEXT_MINOR_VERSION, 3,
+        EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+        EGL_NONE
+    };
+
+    context = eglCreateContext(eglDisplay, config, EGL_NO_CONTEXT, contextAttribs);
+    if (context == EGL_NO_CONTEXT)
+    {
+        context = nullptr;
+        std::cout << "Failed to create EGL context\n";
+        destroy();
+        return false;
+    }
+
+    // Without surfaceless support a context still needs some surface to be
+    // current; the FBO is what actually gets rendered to.
+    EGLSurface eglSurface = EGL_NO_SURFACE;
+    if (!surfaceless)
+    {
+        const EGLint pbufferAttribs[] = { EGL_WIDTH, 1, EGL_HEIGHT, 1, EGL_NONE };
+        eglSurface = eglCreatePbufferSurface(eglDisplay, config, pbufferAttribs);
+        if (eglSurface == EGL_NO_SURFACE)
+        {
+            std::cout << "Failed to create EGL pbuffer\n";
+            destroy();
+            return false;
+        }
+        surface = eglSurface;
+    }
+
+    if (!eglMakeCurrent(eglDisplay, eglSurface, eglSurface, (EGLContext)context))
+    {
+        std::cout << "Failed to make EGL context current\n";
+        destroy();
+        return false;
+    }
+
+    return true;
+}
+
+void* OffscreenContext::getProcAddress(const char* name)
+{
+    return (void*)eglGetProcAddress(name);
+}
+
+void OffscreenContext::destroy()
+{
+    if (!display)
+        return;
+
+    if (target.framebuffer() && eglGetCurrentContext() == (EGLContext)context)
+    {
+        target.release();
+        targetPool.destroy();
+    }
+
+    std::lock_guard<std::recursive_mutex> lock(displayMutex);
+
+    eglMakeCurrent((EGLDisplay)display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    if (surface)
+        eglDestroySurface((EGLDisplay)display, (EGLSurface)surface);
+    if (context)
+        eglDestroyContext((EGLDisplay)display, (EGLContext)context);
+
+    if (--displayUsers[(EGLDisplay)display] == 0)
+    {
+        displayUsers.erase((EGLDisplay)display);
+        eglTerminate((EGLDisplay)display);
+    }
+
+    display = surface = context = nullptr;
+}
+
+#else
+
+bool OffscreenContext::create(int, int)
+{
+    std::cout << "Offscreen backend not available: built without EGL\n";
+    return false;
+}
+
+void* OffscreenContext::getProcAddress(const char*)
+{
+    return nullptr;
+}
+
+void OffscreenContext::destroy()
+{
+}
+
+#endif
+
+// ===============================
+// Render target
+// ===============================
+bool OffscreenContext::createFramebuffer()
+{
+    target.resize(fbWidth, fbHeight);
+    if (!target.bind())
+    {
+        std::cout << "Offscreen framebuffer is incomplete\n";
+        return false;
+    }
+
+    // The samples draw to "the" framebuffer, so keep this one bound
+    glViewport(0, 0, fbWidth, fbHeight);
+    return true;
+}
+
+void OffscreenContext::present()
+{
+    glFlush();
+}
+
+OffscreenContext::~OffscreenContext()
+{
+    destroy();
+}
@@ -0,0 +1,115 @@
+#include <renderer/presentation.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <thread>
+
+// Below this much remaining time the limiter stops sleeping and spins
+static const double SPIN_MS = 2.0;
+
+static double nowMs()
+{
+    using namespace std::chrono;
+    return duration<double, std::milli>(steady_clock::now().time_since_epoch()).count();
+}
+
+// ===============================
+// Swap interval
+// ===============================
+int swapIntervalFor(PresentMode mode, bool benchmark, bool tearControl)
+{
+    switch (mode)
+    {
+    case PresentMode::Auto:
+        return benchmark ? 0 : 1;
+    case PresentMode::Vsync:
+        return 1;
+    case PresentMode::Immediate:
+        return 0;
+    case PresentMode::Adaptive:
+        return tearControl ? -1 : 1;
+    }
+    return 1;
+}
+
+// ===============================
+// Frame limiter
+// ===============================
+void FrameLimiter::setTargetFps(double fps)
+{
+    periodMs = fps > 0.0 ? 1000.0 / fps : 0.0;
+    nextFrameMs = 0.0;
+}
+
+void FrameLimiter::wait()
+{
+    if (!enabled())
+        return;
+
+    double now = nowMs();
+    if (nextFrameMs == 0.0 || now - nextFrameMs > periodMs)
+    {
+        // First frame, or more than a whole frame late: restart the schedule
+        nextFrameMs = now + periodMs;
+        return;
+    }
+
+    double remaining = nextFrameMs - now;
+    if (remaining > SPIN_MS)
+        std::this_thread::sleep_for(std::chrono::duration<double, std::milli>(remaining - SPIN_MS));
+
+    while (nowMs() < nextFrameMs)
+        std::this_thread::yield();
+
+    nextFrameMs += periodMs;
+}
+
+// ===============================
+// Present telemetry
+// ===============================
+void PresentStats::framePresented()
+{
+    double now = nowMs();
+
+    if (lastMs >= 0.0)
+    {
+        double interval = now - lastMs;
+        sumMs += interval;
+        sumSquaresMs += interval * interval;
+        if (interval > worstMs)
+            worstMs = interval;
+    }
+
+    lastMs = now;
+    ++count;
+}
+
+double PresentStats::averageIntervalMs() const
+{
+    return count > 1 ? sumMs / (double)(count - 1) : 0.0;
+}
+
+double PresentStats::averageFps() const
+{
+    double interval = averageIntervalMs();
+    return interval > 0.0 ? 1000.0 / interval : 0.0;
+}
+
+double PresentStats::jitterMs() const
+{
+    if (count < 2)
+        return 0.0;
+
+    double mean = averageIntervalMs();
+    double variance = sumSquaresMs / (double)(count - 1) - mean * mean;
+    return variance > 0.0 ? std::sqrt(variance) : 0.0;
+}
+
+void PresentStats::print(std::ostream& out) const
+{
+    char line[160];
+    std::snprintf(line, sizeof(line), "Presented %llu frames: %.2f fps, interval %.4f ms avg, %.4f ms max, jitter %.4f ms\n",
+        count, averageFps(), averageIntervalMs(), maxIntervalMs(), jitterMs());
+    out << line;
+}
@@ -0,0 +1,232 @@
+#include <glad/glad.h>
+
+#include <renderer/program_cache.h>
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+// ===============================
+// File layout
+// ===============================
+//   u32 magic, u32 layout version, u64 key
+//   3 x (u32 length + bytes)   vendor, renderer, version
+//   u32 binary format, u32 binary length, binary bytes
+static const std::uint32_t CACHE_MAGIC = 0x42504c47; // "GLPB"
+static const std::uint32_t CACHE_LAYOUT = 1;
+
+// FNV-1a, 64 bit
+static std::uint64_t hashBytes(std::uint64_t hash, const char* data, size_t size)
+{
+    for (size_t i = 0; i < size; ++i)
+    {
+        hash ^= (unsigned char)data[i];
+        hash *= 0x100000001b3ull;
+    }
+    return hash;
+}
+
+static std::uint64_t hashString(std::uint64_t hash, const std::string& text)
+{
+    // Include the terminator so "ab"+"c" and "a"+"bc" differ
+    return hashBytes(hash, text.c_str(), text.size() + 1);
+}
+
+static void writeU32(std::ostream& out, std::uint32_t value)
+{
+    out.write((const char*)&value, sizeof(value));
+}
+
+static bool readU32(std::istream& in, std::uint32_t& value)
+{
+    return (bool)in.read((char*)&value, sizeof(value));
+}
+
+static void writeString(std::ostream& out, const std::string& text)
+{
+    writeU32(out, (std::uint32_t)text.size());
+    out.write(text.data(), (std::streamsize)text.size());
+}
+
+static bool readString(std::istream& in, std::string& text)
+{
+    std::uint32_t size = 0;
+    if (!readU32(in, size) || size > 4096)
+        return false;
+
+    text.resize(size);
+    return (bool)in.read(&text[0], size);
+}
+
+// ===============================
+// ProgramCache
+// ===============================
+ProgramCache::ProgramCache(std::string directory)
+    : directory(std::move(directory))
+{
+}
+
+void ProgramCache::queryDriver()
+{
+    if (queried)
+        return;
+    queried = true;
+
+    if (directory.empty() || !GLAD_GL_VERSION_4_1)
+        return;
+
+    GLint formats = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+    if (formats <= 0)
+        return;
+
+    auto glString = [](GLenum name) -> std::string
+    {
+        const char* value = (const char*)glGetString(name);
+        return value ? value : "";
+    };
+
+    vendor = glString(GL_VENDOR);
+    renderer = glString(GL_RENDERER);
+    version = glString(GL_VERSION);
+
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    if (error)
+    {
+        std::cout << "Shader cache disabled, cannot create " << directory << "\n";
+        return;
+    }
+
+    usable = true;
+}
+
+std::uint64_t ProgramCache::keyFor(const char* vertexSource, const char* fragmentSource) const
+{
+    std::uint64_t hash = 0xcbf29ce484222325ull;
+    hash = hashString(hash, vertexSource);
+    hash = hashString(hash, fragmentSource);
+    hash = hashString(hash, vendor);
+    hash = hashString(hash, renderer);
+    hash = hashString(hash, version);
+    return hash;
+}
+
+std::string ProgramCache::pathFor(std::uint64_t key) const
+{
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.bin", (unsigned long long)key);
+    return (std::filesystem::path(directory) / name).string();
+}
+
+GlProgram ProgramCache::load(const char* vertexSource, const char* fragmentSource)
+{
+    queryDriver();
+    if (!usable)
+        return GlProgram();
+
+    std::uint64_t key = keyFor(vertexSource, fragmentSource);
+    std::ifstream file(pathFor(key), std::ios::binary);
+    if (!file)
+    {
+        ++missCount;
+        return GlProgram();
+    }
+
+    // Any mismatch means a different driver (or a hash collision):
+    // treat as a miss and let the caller recompile + overwrite
+    std::uint32_t magic = 0, layout = 0, format = 0, length = 0;
+    std::uint64_t storedKey = 0;
+    std::string storedVendor, storedRenderer, storedVersion;
+
+    bool valid =
+        readU32(file, magic) && magic == CACHE_MAGIC &&
+        readU32(file, layout) && layout == CACHE_LAYOUT &&
+        file.read((char*)&storedKey, sizeof(storedKey)) && storedKey == key &&
+        readString(file, storedVendor) && storedVendor == vendor &&
+        readString(file, storedRenderer) && storedRenderer == renderer &&
+        readString(file, storedVersion) && storedVersion == version &&
+        readU32(file, format) &&
+        readU32(file, length) && length > 0;
+
+    std::vector<char> binary;
+    if (valid)
+    {
+        binary.resize(length);
+        valid = (bool)file.read(binary.data(), length);
+    }
+
+    if (!valid)
+    {
+        ++missCount;
+        return GlProgram();
+    }
+
+    GlProgram program = GlProgram::create();
+    glProgramBinary(program.get(), format, binary.data(), (GLsizei)length);
+
+    int success = 0;
+    glGetProgramiv(program.get(), GL_LINK_STATUS, &success);
+    if (!success)
+    {
+        // Driver updated in a way the version string did not reveal
+        ++missCount;
+        return GlProgram();
+    }
+
+    ++hitCount;
+    return program;
+}
+
+void ProgramCache::store(const char* vertexSource, const char* fragmentSource, unsigned int program)
+{
+    queryDriver();
+    if (!usable)
+        return;
+
+    int success = 0;
+    glGetProgramiv(program, GL_LINK_STATUS, &success);
+    if (!success)
+        return;
+
+    GLint length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0)
+        return;
+
+    std::vector<char> binary((size_t)length);
+    GLenum format = 0;
+    glGetProgramBinary(program, length, &length, &format, binary.data());
+
+    std::string path = pathFor(keyFor(vertexSource, fragmentSource));
+    std::string tempPath = path + ".tmp";
+
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file)
+            return;
+
+        std::uint64_t key = keyFor(vertexSource, fragmentSource);
+        writeU32(file, CACHE_MAGIC);
+        writeU32(file, CACHE_LAYOUT);
+        file.write((const char*)&key, sizeof(key));
+        writeString(file, vendor);
+        writeString(file, renderer);
+        writeString(file, version);
+        writeU32(file, (std::uint32_t)format);
+        writeU32(file, (std::uint32_t)length);
+        file.write(binary.data(), length);
+
+        if (!file)
+            return;
+    }
+
+    // Rename so a concurrent reader never sees a half-written entry
+    std::error_code error;
+    std::filesystem::rename(tempPath, path, error);
+    if (error)
+        std::filesystem::remove(tempPath, error);
+}
@@ -0,0 +1,322 @@
+#include <renderer/render_options.h>
+
+#include <cctype>
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <thread>
+
+// ===============================
+// Argument helpers
+// ===============================
+// Upper bounds for counts that size allocations; past these a typo would
+// only end in an out-of-memory abort
+static const unsigned long long MAX_INSTANCES = 1ull << 20;
+static const unsigned long long MAX_BATCH = 1ull << 20;
+
+// Digits only: strtoull would take "-1" and wrap it to 2^64 - 1
+static bool parseCount(const char* text, unsigned long long& value, unsigned long long max = ULLONG_MAX)
+{
+    if (!std::isdigit((unsigned char)text[0]))
+        return false;
+
+    errno = 0;
+    char* end = nullptr;
+    unsigned long long parsed = std::strtoull(text, &end, 10);
+    if (*end != '\0' || errno == ERANGE || parsed > max)
+        return false;
+
+    value = parsed;
+    return true;
+}
+
+static bool parseFraction(const char* text, double& value)
+{
+    char* end = nullptr;
+    double parsed = std::strtod(text, &end);
+    if (end == text || *end != '\0' || !(parsed >= 0.0 && parsed <= 1.0))
+        return false;
+
+    value = parsed;
+    return true;
+}
+
+ParseResult parseRenderOptions(int argc, char** argv, RenderOptions& options)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        const char* arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+
+        if (std::strcmp(arg, "--help") == 0)
+        {
+            printRenderUsage(argv[0]);
+            return ParseResult::Help;
+        }
+        else if (std::strcmp(arg, "--backend") == 0 && value)
+        {
+            if (std::strcmp(value, "window") == 0)
+                options.backend = ContextBackend::Window;
+            else if (std::strcmp(value, "egl") == 0)
+                options.backend = ContextBackend::Egl;
+            else if (std::strcmp(value, "software") == 0)
+                options.backend = ContextBackend::Software;
+            else
+            {
+                std::cout << "Unknown backend: " << value << "\n";
+                printRenderUsage(argv[0]);
+                return ParseResult::Error;
+            }
+            ++i;
+        }
+        else if (std::strcmp(arg, "--frames") == 0 && value)
+        {
+            if (!parseCount(value, options.frames))
+            {
+                std::cout << "Invalid frame count: " << value << "\n";
+                return ParseResult::Error;
+            }
+            ++i;
+        }
+        else if (std::strcmp(arg, "--benchmark") == 0)
+        {
+            options.benchmark = true;
+        }
+        else if (std::strcmp(arg, "--warmup") == 0 && value)
+        {
+            if (!parseCount(value, options.warmupFrames))
+            {
+                std::cout << "Invalid warm-up count: " << value << "\n";
+                return ParseResult::Error;
+            }
+            ++i;
+        }
+        else if (std::strcmp(arg, "--benchmark-out") == 0 && value)
+        {
+            options.benchmarkOut = value;
+            ++i;
+        }
+        else if (std::strcmp(arg, "--lazy-gl") == 0)
+        {
+            options.lazyGL = true;
+        }
+        else if (std::strcmp(arg, "--shader-cache") == 0 && value)
+        {
+            options.shaderCacheDir = value;
+            ++i;
+        }
+        else if (std::strcmp(arg, "--stream") == 0)
+        {
+            options.stream = true;
+        }
+        else if (std::strcmp(arg, "--arena") == 0)
+        {
+            options.arena = true;
+        }
+        else if (std::strcmp(arg, "--wide-indices") == 0)
+        {
+            options.wideIndices = true;
+        }
+        else if (std::strcmp(arg, "--instances") == 0 && value)
+        {
+            if (!parseCount(value, options.instances, MAX_INSTANCES))
+            {
+                std::cout << "Invalid instance count: " << value << "\n";
+                return ParseResult::Error;
+            }
+            ++i;
+        }
+        else if (std::strcmp(arg, "--batch") == 0 && value)
+        {
+            if (!parseCount(value, options.batch, MAX_BATCH))
+            {
+                std::cout << "Invalid batch size: " << value << "\n";
+                return ParseResult::Error;
+            }
+            ++i;
+        }
+        else if (std::strcmp(arg, "--gpu-profile") == 0)
+        {
+            options.gpuProfile = true;
+        }
+        else if (std::strcmp(arg, "--present") == 0 && value)
+        {
+            if (std::strcmp(value, "auto") == 0)
+                options.presentMode = PresentMode::Auto;
+            else if (std::strcmp(value, "vsync") == 0)
+                options.presentMode = PresentMode::Vsync;
+            else if (std::strcmp(value, "immediate") == 0)
+                options.presentMode = PresentMode::Immediate;
+            else if (std::strcmp(value, "adaptive") == 0)
+                options.presentMode = PresentMode::Adaptive;
+            else
+            {
+                std::cout << "Unknown present mode: " << value << "\n";
+                printRenderUsage(argv[0]);
+                return ParseResult::Error;
+            }
+            ++i;
+        }
+        else if (std::strcmp(arg, "--fps-limit") == 0 && value)
+        {
+            if (!parseCount(value, options.fpsLimit))
+            {
+                std::cout << "Invalid frame rate: " << value << "\n";
+                return ParseResult::Error;
+            }
+            ++i;
+        }
+        else if (std::strcmp(arg, "--frames-in-flight") == 0 && value)
+        {
+            if (!parseCount(value, options.framesInFlight) || options.framesInFlight < 1 || options.framesInFlight > 3)
+            {
+                std::cout << "Frames in flight must be 1, 2 or 3: " << value << "\n";
+                return ParseResult::Error;
+            }
+            ++i;
+        }
+        else if (std::strcmp(arg, "--idle") == 0)
+        {
+            options.idle = true;
+        }
+        else if (std::strcmp(arg, "--render-thread") == 0)
+        {
+            options.renderThread = true;
+        }
+        else if (std::strcmp(arg, "--capture") == 0 && value)
+        {
+            options.captureDir = value;
+            ++i;
+        }
+        else if (std::strcmp(arg, "--capture-raw") == 0)
+        {
+            options.captureRaw = true;
+        }
+        else if (std::strcmp(arg, "--compare") == 0 && value)
+        {
+            options.compareReference = value;
+            ++i;
+        }
+        else if (std::strcmp(arg, "--tolerance") == 0 && value)
+        {
+            if (!parseCount(value, options.compareTolerance) || options.compareTolerance > 255)
+            {
+                std::cout << "Tolerance must be 0-255: " << value << "\n";
+                return ParseResult::Error;
+            }
+            ++i;
+        }
+        else if (std::strcmp(arg, "--max-bad") == 0 && value)
+        {
+            if (!parseFraction(value, options.compareMaxBad))
+            {
+                std::cout << "Bad pixel fraction must be 0-1: " << value << "\n";
+                return ParseResult::Error;
+            }
+            ++i;
+        }
+        else if (std::strcmp(arg, "--min-ssim") == 0 && value)
+        {
+            if (!parseFraction(value, options.compareMinSsim))
+            {
+                std::cout << "SSIM threshold must be 0-1: " << value << "\n";
+                return ParseResult::Error;
+            }
+            ++i;
+        }
+        else if (std::strcmp(arg, "--diff") == 0 && value)
+        {
+            options.compareDiffPath = value;
+            ++i;
+        }
+        else if (std::strcmp(arg, "--output") == 0 && value)
+        {
+            options.outputPath = value;
+            ++i;
+        }
+        else if (std::strcmp(arg, "--threads") == 0 && value)
+        {
+            if (!parseCount(value, options.threads))
+            {
+                std::cout << "Invalid thread count: " << value << "\n";
+                return ParseResult::Error;
+            }
+
+            // Past a few threads per core the bins only get smaller
+            unsigned int cores = std::thread::hardware_concurrency();
+            unsigned long long maxThreads = 4ull * (cores ? cores : 4);
+            if (options.threads > maxThreads)
+            {
+                std::cout << "--threads " << options.threads << " capped at " << maxThreads << "\n";
+                options.threads = maxThreads;
+            }
+            ++i;
+        }
+        else
+        {
+            std::cout << "Unknown argument: " << arg << "\n";
+            printRenderUsage(argv[0]);
+            return ParseResult::Error;
+        }
+    }
+
+    if (options.benchmark && options.frames == 0)
+        options.frames = 600;
+
+    // The window's back buffer is gone after the swap; headless targets keep it
+    if (!options.compareReference.empty() && options.backend == ContextBackend::Window)
+    {
+        std::cout << "--compare needs --backend egl or software\n";
+        return ParseResult::Error;
+    }
+    if (!options.outputPath.empty() && options.backend == ContextBackend::Window)
+    {
+        std::cout << "--output needs --backend egl or software\n";
+        return ParseResult::Error;
+    }
+    // The CPU rasterizer has no multi-draw path
+    if (options.batch > 0 && options.backend == ContextBackend::Software)
+    {
+        std::cout << "--batch needs --backend window or egl\n";
+        return ParseResult::Error;
+    }
+
+    return ParseResult::Run;
+}
+
+void printRenderUsage(const char* program)
+{
+    std::cout
+        << "Usage: " << program << " [options]\n"
+        << "  --backend window|egl|software\n"
+        << "                         context backend (default: window)\n"
+        << "  --frames N             frames to render before exiting\n"
+        << "  --benchmark            time N measured frames and print a JSON report\n"
+        << "  --warmup N             untimed frames before measuring (default: 60)\n"
+        << "  --benchmark-out FILE   write the report to FILE instead of stdout\n"
+        << "  --lazy-gl              resolve GL functions on first call, not at startup\n"
+        << "  --shader-cache DIR     reuse linked program binaries stored in DIR\n"
+        << "  --stream               upload geometry every frame via the stream buffer\n"
+        << "  --arena                place static geometry in shared GPU buffer arenas\n"
+        << "  --wide-indices         keep 32-bit indices (no 8/16-bit packing)\n"
+        << "  --instances N          draw N copies with one instanced call (N <= 1048576)\n"
+        << "  --batch N              draw N objects with one multi-draw indirect call (N <= 1048576)\n"
+        << "  --gpu-profile          report average GPU time of clear / draw / swap\n"
+        << "  --present auto|vsync|immediate|adaptive\n"
+        << "                         swap interval (default: immediate for benchmarks, else vsync)\n"
+        << "  --fps-limit N          cap the frame rate on the CPU (sleep + spin)\n"
+        << "  --frames-in-flight N   fence-pace the CPU to N frames ahead of the GPU (1-3)\n"
+        << "  --idle                 redraw only when something changed, sleep otherwise\n"
+        << "  --render-thread        render on a dedicated thread, poll events on main\n"
+        << "  --capture DIR          write every frame to DIR (async readback, PNG)\n"
+        << "  --capture-raw          with --capture: raw RGBA8 files instead of PNG\n"
+        << "  --compare FILE         headless: check the last frame against a reference PNG\n"
+        << "  --tolerance N          with --compare: per-channel tolerance (default: 2)\n"
+        << "  --max-bad X            with --compare: fraction of pixels over tolerance (default: 0.001)\n"
+        << "  --min-ssim X           with --compare: worst 8x8 block SSIM (default: 0.95)\n"
+        << "  --diff FILE            with --compare: heatmap path (default: diff.png)\n"
+        << "  --output FILE          save the last frame as PNG (egl / software)\n"
+        << "  --threads N            software backend: binned rasterizer on N threads\n";
+}
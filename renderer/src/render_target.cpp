@@ -0,0 +1,127 @@
+#include <glad/glad.h>
+
+#include <renderer/render_target.h>
+
+#include <iostream>
+
+// ===============================
+// Pool
+// ===============================
+int RenderTargetPool::bucketed(int size)
+{
+    if (size < 1)
+        size = 1;
+    return (size + BUCKET - 1) / BUCKET * BUCKET;
+}
+
+RenderTargetPool::Storage RenderTargetPool::acquire(int width, int height)
+{
+    width = bucketed(width);
+    height = bucketed(height);
+
+    // Most recently released first: likeliest to be the size dragged back to
+    for (size_t i = freeList.size(); i-- > 0;)
+    {
+        if (freeList[i].width == width && freeList[i].height == height)
+        {
+            Storage storage = freeList[i];
+            freeList.erase(freeList.begin() + (std::ptrdiff_t)i);
+            ++reused;
+            return storage;
+        }
+    }
+
+    Storage storage;
+    storage.width = width;
+    storage.height = height;
+
+    glGenFramebuffers(1, &storage.fbo);
+    glGenRenderbuffers(1, &storage.color);
+    glGenRenderbuffers(1, &storage.depth);
+
+    glBindRenderbuffer(GL_RENDERBUFFER, storage.color);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+
+    glBindRenderbuffer(GL_RENDERBUFFER, storage.depth);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width, height);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, storage.fbo);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, storage.color);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, storage.depth);
+
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+    {
+        std::cout << "Render target " << width << "x" << height << " is incomplete\n";
+        free(storage);
+        return Storage();
+    }
+
+    ++allocated;
+    return storage;
+}
+
+void RenderTargetPool::release(const Storage& storage)
+{
+    if (!storage.fbo)
+        return;
+
+    freeList.push_back(storage);
+    if (freeList.size() > MAX_FREE)
+    {
+        free(freeList.front());
+        freeList.erase(freeList.begin());
+    }
+}
+
+void RenderTargetPool::destroy()
+{
+    for (Storage& storage : freeList)
+        free(storage);
+    freeList.clear();
+}
+
+void RenderTargetPool::free(Storage& storage)
+{
+    glDeleteFramebuffers(1, &storage.fbo);
+    glDeleteRenderbuffers(1, &storage.color);
+    glDeleteRenderbuffers(1, &storage.depth);
+    storage = Storage();
+}
+
+// ===============================
+// Target
+// ===============================
+void RenderTarget::resize(int newWidth, int newHeight)
+{
+    requestedWidth = newWidth;
+    requestedHeight = newHeight;
+}
+
+bool RenderTarget::bind()
+{
+    int width = RenderTargetPool::bucketed(requestedWidth);
+    int height = RenderTargetPool::bucketed(requestedHeight);
+
+    // Same bucket: the storage already fits, only the viewport differs
+    if (!storage.fbo || storage.width != width || storage.height != height)
+    {
+        // Acquire before releasing, so the release cannot evict the very
+        // storage this size could have reused
+        RenderTargetPool::Storage next = pool.acquire(width, height);
+        if (!next.fbo)
+            return false;
+
+        pool.release(storage);
+        storage = next;
+    }
+
+    glBindFramebuffer(GL_FRAMEBUFFER, storage.fbo);
+    return true;
+}
+
+void RenderTarget::release()
+{
+    pool.release(storage);
+    storage = RenderTargetPool::Storage();
+}
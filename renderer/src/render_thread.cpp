@@ -0,0 +1,52 @@
+#include <renderer/render_thread.h>
+
+#include <chrono>
+#include <utility>
+
+RenderThread::~RenderThread()
+{
+    join();
+}
+
+void RenderThread::start(std::function<void()> loop, std::function<void()> wake)
+{
+    isRunning.store(true, std::memory_order_release);
+
+    thread = std::thread([this, loop = std::move(loop), wake = std::move(wake)]
+    {
+        loop();
+        isRunning.store(false, std::memory_order_release);
+
+        if (wake)
+            wake();
+    });
+}
+
+void RenderThread::join()
+{
+    if (thread.joinable())
+        thread.join();
+}
+
+// ===============================
+// Commands
+// ===============================
+bool RenderThread::post(const RenderCommand& command)
+{
+    if (!commands.push(command))
+        return false;
+
+    // Taking the lock orders the push before a sleeper's empty check, so
+    // the notification cannot fall between its check and its wait
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+    }
+    wake.notify_one();
+    return true;
+}
+
+void RenderThread::waitForCommand(double timeoutMs)
+{
+    std::unique_lock<std::mutex> lock(wakeMutex);
+    wake.wait_for(lock, std::chrono::duration<double, std::milli>(timeoutMs), [this] { return !commands.empty(); });
+}
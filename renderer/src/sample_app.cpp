@@ -0,0 +1,669 @@
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <renderer/batch_renderer.h>
+#include <renderer/frame_benchmark.h>
+#include <renderer/frame_capture.h>
+#include <renderer/frame_pacer.h>
+#include <renderer/gl_loader.h>
+#include <renderer/gl_state_cache.h>
+#include <renderer/gpu_arena.h>
+#include <renderer/gpu_profiler.h>
+#include <renderer/image_compare.h>
+#include <renderer/image_io.h>
+#include <renderer/index_buffer.h>
+#include <renderer/instancing.h>
+#include <renderer/offscreen_context.h>
+#include <renderer/presentation.h>
+#include <renderer/program_cache.h>
+#include <renderer/render_options.h>
+#include <renderer/render_thread.h>
+#include <renderer/sample_app.h>
+#include <renderer/shader_compiler.h>
+#include <renderer/software_backend.h>
+
+#include <iostream>
+#include <vector>
+
+// What the GLFW callbacks reach through the window user pointer
+struct WindowState
+{
+    GlStateCache* stateCache = nullptr;
+    RenderThread* renderThread = nullptr; // set while --render-thread owns the context
+    bool damaged = true;                  // --idle: something changed since the last frame
+
+    // Latest framebuffer size, applied once per frame however many resize
+    // events arrived (or forwarded once per event batch with --render-thread)
+    bool resizePending = false;
+    int pendingWidth = 0;
+    int pendingHeight = 0;
+};
+
+// Terminates GLFW on every way out of runSample, early returns included.
+// Declared before anything owning GL objects, so it runs after their
+// destructors, while the context still exists.
+struct GlfwSession
+{
+    bool initialized = false;
+
+    ~GlfwSession()
+    {
+        if (initialized)
+            glfwTerminate();
+    }
+};
+
+// --idle: longest sleep between checks while nothing changes
+static const double IDLE_TIMEOUT_MS = 250.0;
+
+// Per-frame region of the streaming ring (--stream)
+static const size_t STREAM_REGION_BYTES = 4 * 1024 * 1024;
+
+// Size of each geometry arena (--arena)
+static const size_t ARENA_BYTES = 1024 * 1024;
+
+// ===============================
+// Input handling
+// ===============================
+static void processInput(GLFWwindow* window)
+{
+    if (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS)
+        glfwSetWindowShouldClose(window, true);
+}
+
+// ===============================
+// Resize callback
+// ===============================
+static void framebuffer_size_callback(GLFWwindow* window, int width, int height)
+{
+    // Only remember the size: the render loop (or, with --render-thread,
+    // the event loop) picks up the latest one once per frame / batch
+    WindowState* state = static_cast<WindowState*>(glfwGetWindowUserPointer(window));
+    state->resizePending = true;
+    state->pendingWidth = width;
+    state->pendingHeight = height;
+    state->damaged = true;
+}
+
+// ===============================
+// Damage callback (--idle)
+// ===============================
+static void window_damage_callback(GLFWwindow* window)
+{
+    WindowState* state = static_cast<WindowState*>(glfwGetWindowUserPointer(window));
+
+    // Dropped when the queue is full; a redraw is already pending then
+    if (state->renderThread)
+        state->renderThread->post({ RenderCommand::Type::Redraw });
+    else
+        state->damaged = true;
+}
+
+int runSample(int argc, char** argv, const SampleDesc& sample)
+{
+    RenderOptions options;
+    ParseResult parsed = parseRenderOptions(argc, argv, options);
+    if (parsed != ParseResult::Run)
+        return parsed == ParseResult::Help ? 0 : -1;
+
+    // Only samples that provide batch meshes have a batched path
+    if (options.batch > 0 && sample.batchMeshes.empty())
+    {
+        std::cout << "--batch is not supported by the " << sample.label << " sample\n";
+        return -1;
+    }
+
+    if (options.backend == ContextBackend::Software)
+    {
+        // ===============================
+        // No GL at all: CPU reference renderer
+        // ===============================
+        SoftwareScene scene =
+        {
+            sample.mesh.positions, sample.mesh.vertexCount,
+            sample.mesh.indices, sample.mesh.indexCount,
+            sample.fragmentShaderCpu,
+            { sample.clearColor[0], sample.clearColor[1], sample.clearColor[2], sample.clearColor[3] }
+        };
+
+        return runSoftwareBackend(options, sample.label, scene, sample.width, sample.height);
+    }
+
+    GlfwSession glfw;
+    GLFWwindow* window = nullptr;
+    OffscreenContext offscreen;
+    GlStateCache stateCache;
+    RenderThread renderThread;
+    WindowState windowState;
+    windowState.stateCache = &stateCache;
+
+    if (options.backend == ContextBackend::Window)
+    {
+        // ===============================
+        // 1. Initialize GLFW
+        // ===============================
+        glfwInit();
+        glfw.initialized = true;
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+        glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+
+#ifdef __APPLE__
+        glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+#endif
+
+        // ===============================
+        // 2. Create window + context
+        // ===============================
+        window = glfwCreateWindow(sample.width, sample.height, sample.windowTitle, nullptr, nullptr);
+
+        if (!window)
+        {
+            std::cout << "Failed to create GLFW window\n";
+            return -1;
+        }
+
+        glfwMakeContextCurrent(window);
+        glfwSetWindowUserPointer(window, &windowState);
+        glfwSetFramebufferSizeCallback(window, framebuffer_size_callback);
+
+        // --idle: input and expose events are what make a redraw necessary
+        if (options.idle)
+        {
+            glfwSetWindowRefreshCallback(window, window_damage_callback);
+            glfwSetKeyCallback(window, [](GLFWwindow* w, int, int, int, int) { window_damage_callback(w); });
+            glfwSetMouseButtonCallback(window, [](GLFWwindow* w, int, int, int) { window_damage_callback(w); });
+            glfwSetCursorPosCallback(window, [](GLFWwindow* w, double, double) { window_damage_callback(w); });
+        }
+    }
+    else
+    {
+        // ===============================
+        // 1-2. Headless context (no display needed)
+        // ===============================
+        if (!offscreen.create(sample.width, sample.height))
+        {
+            std::cout << "Failed to create offscreen context\n";
+            return -1;
+        }
+
+        // Offscreen runs must end on their own
+        if (options.frames == 0 && !options.benchmark)
+            options.frames = 1;
+    }
+
+    // ===============================
+    // 3. Load OpenGL functions (GLAD)
+    // ===============================
+    GLADloadproc loader = window
+        ? (GLADloadproc)glfwGetProcAddress
+        : (GLADloadproc)OffscreenContext::getProcAddress;
+
+    // --lazy-gl: entry points resolve on first call (timed either way)
+    GlLoadStats glLoad;
+    if (!loadGLFunctions(loader, options.lazyGL, glLoad))
+    {
+        std::cout << "Failed to initialize GLAD\n";
+        return -1;
+    }
+
+    if (!window && !offscreen.createFramebuffer())
+        return -1;
+
+    // ===============================
+    // 4. Compile Shaders
+    // ===============================
+    // Cache hit: restore the linked binary (no GLSL compile)
+    // Miss: submit compile + link now, check the result in the render loop
+    ProgramCache programCache(options.shaderCacheDir);
+    ShaderCompiler shaderCompiler(&programCache);
+    shaderCompiler.init(loader);
+
+    ShaderCompiler::Handle shaderProgram = shaderCompiler.submit(sample.vertexShaderSource, sample.fragmentShaderSource);
+
+    ShaderCompiler::Handle instancedProgram = 0;
+    if (options.instances > 0)
+        instancedProgram = shaderCompiler.submit(instancedVertexShaderSource, instancedFragmentShaderSource);
+
+    bool batched = options.batch > 0;
+    ShaderCompiler::Handle batchProgram = 0;
+    if (batched)
+        batchProgram = shaderCompiler.submit(BatchRenderer::vertexShaderSource(), BatchRenderer::fragmentShaderSource());
+
+    // A window can show the placeholder for a few frames; offscreen runs
+    // are usually short and their pixels must be the real thing
+    if (!window)
+        shaderCompiler.finishAll();
+
+    // ===============================
+    // 5-6. Buffer objects (GPU)
+    // ===============================
+    // The sample's arrays, uploaded once; --stream adds a second VAO whose
+    // geometry is rewritten into a ring every frame (stand-in for dynamic
+    // geometry)
+    //
+    // --arena: vertices and indices go into one shared buffer each instead
+    // of a VBO + EBO per mesh (no index arena for a non-indexed mesh)
+    GeometryArenas arenas;
+    if (options.arena
+        && !(arenas.vertices.create(ARENA_BYTES) && (!sample.mesh.indices || arenas.indices.create(ARENA_BYTES))))
+    {
+        std::cout << "Arenas disabled, using per-mesh buffers\n";
+        arenas.vertices.destroy();
+        arenas.indices.destroy();
+        options.arena = false;
+    }
+
+    MeshBuffers mesh;
+    mesh.create(sample.mesh, options.arena ? &arenas : nullptr, !options.wideIndices);
+
+    if (options.stream && !mesh.createStreaming(STREAM_REGION_BYTES))
+    {
+        std::cout << "Streaming disabled, using the static buffers\n";
+        options.stream = false;
+    }
+
+    // ===============================
+    // 6c. Instanced mode (--instances N)
+    // ===============================
+    // Per-instance transform + color live in their own VBO, stepped once
+    // per instance, so N copies cost a single draw call
+    InstanceBuffer instances;
+    if (options.instances > 0)
+    {
+        instances.create(options.instances);
+        instances.attach(mesh.vertexArray());
+    }
+
+    // ===============================
+    // 6d. Batched multi-draw (--batch N)
+    // ===============================
+    // The batch meshes share one VBO/EBO pair; every object is one
+    // indirect command, so N objects are still a single draw call
+    BatchRenderer batch;
+    std::vector<BatchRenderer::MeshId> batchMeshes;
+    std::vector<InstanceData> batchObjects;
+
+    if (batched)
+    {
+        for (const MeshData& batchMesh : sample.batchMeshes)
+            batchMeshes.push_back(batch.addMesh(batchMesh.positions, batchMesh.vertexCount, batchMesh.indices, batchMesh.indexCount));
+        batch.build(options.batch);
+
+        batchObjects = layoutInstanceGrid(options.batch);
+    }
+
+    // ===============================
+    // 7. Render Loop
+    // ===============================
+    // Setup above bound things directly; start the cache from scratch
+    stateCache.invalidate();
+
+    unsigned long long frame = 0;
+    unsigned long long frameLimit = options.frames;
+
+    FrameBenchmark benchmark;
+    if (options.benchmark)
+    {
+        benchmark.start(options.warmupFrames, options.frames);
+        frameLimit += options.warmupFrames;
+    }
+
+    GpuProfiler gpuProfiler;
+    if (options.gpuProfile)
+        gpuProfiler.init();
+
+    FramePacer framePacer;
+    if (options.framesInFlight > 0)
+        framePacer.init((int)options.framesInFlight);
+
+    // --capture: every frame is read back through a PBO ring and written by
+    // an encoder thread; size tracked through resizes
+    FrameCapture frameCapture;
+    if (!options.captureDir.empty())
+        frameCapture.start(options.captureDir, options.captureRaw ? FrameCapture::Format::Raw : FrameCapture::Format::Png);
+
+    int captureWidth = sample.width;
+    int captureHeight = sample.height;
+    if (window)
+    {
+        glfwGetFramebufferSize(window, &captureWidth, &captureHeight);
+    }
+    else
+    {
+        captureWidth = offscreen.width();
+        captureHeight = offscreen.height();
+    }
+
+    FrameLimiter frameLimiter;
+    frameLimiter.setTargetFps((double)options.fpsLimit);
+    PresentStats presentStats;
+
+    // --render-thread: this loop runs on the render thread and window events
+    // arrive as RenderCommands; otherwise they are handled inline
+    bool threaded = window && options.renderThread;
+    bool quit = false;
+
+    // --idle: frames are only drawn when damaged; a program still compiling
+    // counts as damage, since its placeholder is about to be replaced
+    bool idle = window && options.idle && !options.benchmark;
+    unsigned long long skippedFrames = 0;
+
+    auto renderLoop = [&]()
+    {
+        // The swap interval belongs to the context: set it on the thread
+        // that owns it
+        if (window)
+        {
+            bool tearControl = glfwExtensionSupported("GLX_EXT_swap_control_tear")
+                || glfwExtensionSupported("WGL_EXT_swap_control_tear");
+            if (options.presentMode == PresentMode::Adaptive && !tearControl)
+                std::cout << "Adaptive vsync not supported, using vsync\n";
+
+            glfwSwapInterval(swapIntervalFor(options.presentMode, options.benchmark, tearControl));
+        }
+        else if (options.presentMode != PresentMode::Auto)
+        {
+            std::cout << "--present has no effect on --backend egl (nothing is swapped)\n";
+        }
+
+        bool damaged = true;
+
+        while (!quit)
+        {
+            if (frameLimit != 0 && frame == frameLimit)
+                break;
+
+            // Nothing to draw: sleep until an event (or the timeout) instead
+            // of spinning through identical frames
+            if (idle && !damaged && !shaderCompiler.pending())
+            {
+                if (threaded)
+                    renderThread.waitForCommand(IDLE_TIMEOUT_MS);
+                else
+                    glfwWaitEventsTimeout(IDLE_TIMEOUT_MS / 1000.0);
+            }
+
+            // Latest size seen this frame (-1 = unchanged)
+            int resizeWidth = -1;
+            int resizeHeight = -1;
+
+            if (threaded)
+            {
+                RenderCommand command;
+                while (renderThread.poll(command))
+                {
+                    if (command.type == RenderCommand::Type::Resize)
+                    {
+                        resizeWidth = command.width;
+                        resizeHeight = command.height;
+                    }
+                    else if (command.type == RenderCommand::Type::Quit)
+                    {
+                        quit = true;
+                    }
+                    damaged = true;
+                }
+            }
+            else if (window)
+            {
+                processInput(window);
+                quit = glfwWindowShouldClose(window);
+
+                damaged = damaged || windowState.damaged;
+                windowState.damaged = false;
+
+                if (windowState.resizePending)
+                {
+                    resizeWidth = windowState.pendingWidth;
+                    resizeHeight = windowState.pendingHeight;
+                    windowState.resizePending = false;
+                }
+            }
+
+            // One viewport change per frame, with the latest size only
+            if (resizeWidth >= 0)
+            {
+                stateCache.viewport(0, 0, resizeWidth, resizeHeight);
+                captureWidth = resizeWidth;
+                captureHeight = resizeHeight;
+            }
+
+            if (quit)
+                break;
+
+            if (idle && !damaged && !shaderCompiler.pending())
+            {
+                ++skippedFrames;
+                continue;
+            }
+            damaged = false;
+
+            // --fps-limit: hold the frame back until its slot
+            frameLimiter.wait();
+
+            benchmark.beginFrame();
+
+            // Waits here if the GPU is --frames-in-flight frames behind
+            framePacer.beginFrame();
+            gpuProfiler.beginFrame();
+
+            gpuProfiler.beginScope("clear");
+            stateCache.clearColor(sample.clearColor[0], sample.clearColor[1], sample.clearColor[2], sample.clearColor[3]);
+            glClear(GL_COLOR_BUFFER_BIT);
+            gpuProfiler.endScope();
+
+            shaderCompiler.poll();
+            stateCache.useProgram(shaderCompiler.program(options.instances > 0 ? instancedProgram : shaderProgram));
+
+            gpuProfiler.beginScope("draw");
+
+            if (batched)
+            {
+                for (size_t i = 0; i < batchObjects.size(); ++i)
+                    batch.draw(batchMeshes[i % batchMeshes.size()], batchObjects[i]);
+
+                batch.submit(stateCache, shaderCompiler.program(batchProgram));
+            }
+            else if (options.instances > 0)
+            {
+                mesh.drawInstanced(stateCache, instances.count());
+            }
+            else if (options.stream)
+            {
+                mesh.drawStreamed(stateCache);
+            }
+            else
+            {
+                mesh.draw(stateCache);
+            }
+
+            gpuProfiler.endScope();
+
+            // Queued before the swap, while the back buffer still holds the frame
+            frameCapture.capture(window ? 0 : offscreen.framebuffer(), captureWidth, captureHeight);
+
+            benchmark.beginSwap();
+            gpuProfiler.beginScope("swap");
+            if (window)
+                glfwSwapBuffers(window);
+            else
+                offscreen.present();
+            gpuProfiler.endScope();
+            benchmark.endSwap();
+
+            // Same window as the benchmark: warm-up presents are not counted
+            if (options.benchmark && frame == options.warmupFrames)
+                presentStats = PresentStats();
+            presentStats.framePresented();
+            framePacer.endFrame();
+
+            if (window && !threaded)
+                glfwPollEvents();
+
+            gpuProfiler.endFrame();
+            benchmark.endFrame();
+            stateCache.endFrame();
+            ++frame;
+        }
+    };
+
+    if (threaded)
+    {
+        // ===============================
+        // 7b. Event thread
+        // ===============================
+        // The context moves to the render thread; this thread only waits
+        // for events, so input stays responsive while a swap blocks
+        windowState.renderThread = &renderThread;
+        glfwMakeContextCurrent(nullptr);
+
+        renderThread.start(
+            [&]
+            {
+                glfwMakeContextCurrent(window);
+                renderLoop();
+                glfwMakeContextCurrent(nullptr);
+            },
+            [] { glfwPostEmptyEvent(); }
+        );
+
+        bool quitPosted = false;
+        while (renderThread.running())
+        {
+            glfwWaitEvents();
+            processInput(window);
+
+            // One Resize per batch of events, however many the drag produced;
+            // kept pending if the queue is full
+            if (windowState.resizePending)
+            {
+                RenderCommand resize = { RenderCommand::Type::Resize, windowState.pendingWidth, windowState.pendingHeight };
+                if (renderThread.post(resize))
+                    windowState.resizePending = false;
+            }
+
+            if (!quitPosted && glfwWindowShouldClose(window))
+                quitPosted = renderThread.post({ RenderCommand::Type::Quit });
+        }
+
+        // Context comes back for the cleanup below
+        renderThread.join();
+        windowState.renderThread = nullptr;
+        glfwMakeContextCurrent(window);
+    }
+    else
+    {
+        renderLoop();
+    }
+
+    // Frames still in the ring; returns once the encoder has written them
+    frameCapture.finish();
+    gpuProfiler.finish();
+
+    // --output / --compare (headless only): the FBO still holds the last frame
+    int exitCode = 0;
+    if (!options.outputPath.empty() || !options.compareReference.empty())
+    {
+        std::vector<unsigned char> pixels((size_t)offscreen.width() * (size_t)offscreen.height() * 4);
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, offscreen.framebuffer());
+        glReadPixels(0, 0, offscreen.width(), offscreen.height(), GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+
+        if (!options.outputPath.empty() && !writePng(options.outputPath, offscreen.width(), offscreen.height(), pixels.data(), true))
+            exitCode = -1;
+        if (!options.compareReference.empty() && !checkReferenceImage(options, pixels.data(), offscreen.width(), offscreen.height(), true))
+            exitCode = 1;
+    }
+
+    if (options.benchmark)
+    {
+        double frames = frame ? (double)frame : 1.0;
+        benchmark.addMetric("gl_load_ms", glLoad.milliseconds);
+        if (glLoad.lazy)
+            benchmark.addMetric("gl_functions_resolved", (double)resolvedGLFunctions(glLoad));
+
+        benchmark.addMetric("gl_state_calls_issued_per_frame", (double)stateCache.total().issued / frames);
+        benchmark.addMetric("gl_state_calls_elided_per_frame", (double)stateCache.total().elided / frames);
+
+        for (const GpuProfiler::ScopeStats& scope : gpuProfiler.scopes())
+            benchmark.addMetric("gpu_" + scope.name + "_ms", scope.averageMs());
+
+        benchmark.addMetric("present_fps", presentStats.averageFps());
+        benchmark.addMetric("present_interval_ms_max", presentStats.maxIntervalMs());
+        benchmark.addMetric("present_jitter_ms", presentStats.jitterMs());
+
+        if (framePacer.enabled())
+        {
+            benchmark.addMetric("frames_in_flight", (double)framePacer.framesInFlight());
+            benchmark.addMetric("pacing_wait_ms_avg", framePacer.averageWaitMs());
+            benchmark.addMetric("pacing_wait_ms_max", framePacer.maxWaitMs());
+            benchmark.addMetric("pacing_blocked_frames", (double)framePacer.blockedFrames());
+        }
+
+        if (frameCapture.framesCaptured() > 0)
+        {
+            benchmark.addMetric("capture_frames_written", (double)frameCapture.framesWritten());
+            benchmark.addMetric("capture_blocked_reads", (double)frameCapture.blockedReads());
+            benchmark.addMetric("capture_encoder_wait_ms", frameCapture.encoderWaitMs());
+        }
+
+        if (sample.mesh.indices)
+        {
+            benchmark.addMetric("index_buffer_bytes", (double)mesh.indexBuffer().bytes.size());
+            benchmark.addMetric("index_bytes_saved", (double)mesh.indexBuffer().bytesSaved());
+            benchmark.addMetric("index_draws_per_mesh", (double)mesh.indexBuffer().chunks.size());
+        }
+
+        if (options.arena)
+        {
+            GpuArena::Stats vertexStats = arenas.vertices.stats();
+            benchmark.addMetric("arena_vertex_bytes_used", (double)vertexStats.used);
+            benchmark.addMetric("arena_vertex_fragmentation", vertexStats.fragmentation());
+            unsigned long long defragmentations = vertexStats.defragmentations;
+
+            if (arenas.indices.valid())
+            {
+                GpuArena::Stats indexStats = arenas.indices.stats();
+                benchmark.addMetric("arena_index_bytes_used", (double)indexStats.used);
+                benchmark.addMetric("arena_index_fragmentation", indexStats.fragmentation());
+                defragmentations += indexStats.defragmentations;
+            }
+            benchmark.addMetric("arena_defragmentations", (double)defragmentations);
+        }
+
+        benchmark.report(sample.label, options.benchmarkOut);
+    }
+    else
+    {
+        if (gpuProfiler.enabled())
+            gpuProfiler.print(std::cout);
+        if (framePacer.enabled())
+            framePacer.print(std::cout);
+        if (frameCapture.framesCaptured() > 0)
+            frameCapture.print(std::cout);
+        if (options.arena)
+        {
+            arenas.vertices.print(std::cout, "vertices");
+            if (arenas.indices.valid())
+                arenas.indices.print(std::cout, "indices");
+        }
+        if (idle)
+            std::cout << "Idle rendering: " << frame << " frames drawn, " << skippedFrames << " wake-ups skipped\n";
+        if (options.presentMode != PresentMode::Auto || frameLimiter.enabled())
+            presentStats.print(std::cout);
+    }
+
+    // ===============================
+    // 8. Cleanup
+    // ===============================
+    gpuProfiler.destroy();
+    framePacer.destroy();
+    mesh.destroy();
+    arenas.vertices.destroy();
+    arenas.indices.destroy();
+    batch.destroy();
+    instances.destroy();
+    shaderCompiler.destroy();
+
+    return exitCode;
+}
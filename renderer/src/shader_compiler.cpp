@@ -0,0 +1,220 @@
+#include <glad/glad.h>
+
+#include <renderer/gl_extensions.h>
+#include <renderer/program_cache.h>
+#include <renderer/shader_compiler.h>
+#include <renderer/shader_program.h>
+
+#include <iostream>
+#include <utility>
+
+// ===============================
+// GL_KHR_parallel_shader_compile
+// ===============================
+// Not part of the generated loader (core-only profile), so the enums and
+// entry point are declared here. The ARB variant shares the enum values.
+#define GL_MAX_SHADER_COMPILER_THREADS_KHR 0x91B0
+#define GL_COMPLETION_STATUS_KHR 0x91B1
+
+typedef void (APIENTRYP PFNGLMAXSHADERCOMPILERTHREADSKHRPROC)(GLuint count);
+
+// ===============================
+// Placeholder (drawn until the real program links)
+// ===============================
+static const char* placeholderVertexSource = R"(
+#version 330 core
+layout (location = 0) in vec3 aPos;
+
+void main()
+{
+    gl_Position = vec4(aPos, 1.0);
+}
+)";
+
+static const char* placeholderFragmentSource = R"(
+#version 330 core
+out vec4 FragColor;
+
+void main()
+{
+    FragColor = vec4(0.35, 0.35, 0.35, 1.0);
+}
+)";
+
+ShaderCompiler::ShaderCompiler(ProgramCache* cache)
+    : cache(cache)
+{
+}
+
+void ShaderCompiler::init(void* (*loader)(const char*))
+{
+    const char* entryPoint = nullptr;
+    if (hasGLExtension("GL_KHR_parallel_shader_compile"))
+        entryPoint = "glMaxShaderCompilerThreadsKHR";
+    else if (hasGLExtension("GL_ARB_parallel_shader_compile"))
+        entryPoint = "glMaxShaderCompilerThreadsARB";
+
+    if (entryPoint && loader)
+    {
+        auto maxThreads = (PFNGLMAXSHADERCOMPILERTHREADSKHRPROC)loader(entryPoint);
+        if (maxThreads)
+        {
+            // 0xFFFFFFFF = let the driver pick its own thread count
+            maxThreads(0xFFFFFFFFu);
+            parallelCompile = true;
+        }
+    }
+
+    // Tiny and compiled once, so the synchronous path is fine here
+    placeholder = buildShaderProgram(placeholderVertexSource, placeholderFragmentSource);
+}
+
+// ===============================
+// Submission
+// ===============================
+ShaderCompiler::Handle ShaderCompiler::submit(const char* vertexSource, const char* fragmentSource)
+{
+    Job job;
+    job.vertexSource = vertexSource;
+    job.fragmentSource = fragmentSource;
+
+    if (cache)
+    {
+        job.program = cache->load(vertexSource, fragmentSource);
+        if (job.program)
+        {
+            job.state = State::Ready;
+            jobs.push_back(std::move(job));
+            return (Handle)(jobs.size() - 1);
+        }
+    }
+
+    job.vertexShader = GlShader::create(GL_VERTEX_SHADER);
+    glShaderSource(job.vertexShader.get(), 1, &vertexSource, nullptr);
+    glCompileShader(job.vertexShader.get());
+
+    job.fragmentShader = GlShader::create(GL_FRAGMENT_SHADER);
+    glShaderSource(job.fragmentShader.get(), 1, &fragmentSource, nullptr);
+    glCompileShader(job.fragmentShader.get());
+
+    // Linking straight away is legal; the driver chains it after the
+    // compiles instead of us waiting on GL_COMPILE_STATUS in between
+    job.program = GlProgram::create();
+    glAttachShader(job.program.get(), job.vertexShader.get());
+    glAttachShader(job.program.get(), job.fragmentShader.get());
+
+    if (cache && GLAD_GL_VERSION_4_1)
+        glProgramParameteri(job.program.get(), GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+
+    glLinkProgram(job.program.get());
+
+    jobs.push_back(std::move(job));
+    ++pendingCount;
+    return (Handle)(jobs.size() - 1);
+}
+
+// ===============================
+// Completion
+// ===============================
+bool ShaderCompiler::completed(const Job& job) const
+{
+    if (!parallelCompile)
+        return true;
+
+    GLint done = GL_FALSE;
+    glGetProgramiv(job.program.get(), GL_COMPLETION_STATUS_KHR, &done);
+    return done == GL_TRUE;
+}
+
+void ShaderCompiler::resolve(Job& job)
+{
+    int success;
+    char infoLog[512];
+
+    glGetProgramiv(job.program.get(), GL_LINK_STATUS, &success);
+    if (success)
+    {
+        job.state = State::Ready;
+        if (cache)
+            cache->store(job.vertexSource.c_str(), job.fragmentSource.c_str(), job.program.get());
+    }
+    else
+    {
+        // Only now is it worth asking which stage broke
+        glGetShaderiv(job.vertexShader.get(), GL_COMPILE_STATUS, &success);
+        if (!success)
+        {
+            glGetShaderInfoLog(job.vertexShader.get(), 512, nullptr, infoLog);
+            std::cout << "Vertex Shader Error:\n" << infoLog << "\n";
+        }
+
+        glGetShaderiv(job.fragmentShader.get(), GL_COMPILE_STATUS, &success);
+        if (!success)
+        {
+            glGetShaderInfoLog(job.fragmentShader.get(), 512, nullptr, infoLog);
+            std::cout << "Fragment Shader Error:\n" << infoLog << "\n";
+        }
+
+        glGetProgramInfoLog(job.program.get(), 512, nullptr, infoLog);
+        std::cout << "Shader Link Error:\n" << infoLog << "\n";
+
+        job.program.reset();
+        job.state = State::Failed;
+    }
+
+    job.vertexShader.reset();
+    job.fragmentShader.reset();
+
+    // Sources are only needed for the cache key
+    job.vertexSource.clear();
+    job.fragmentSource.clear();
+
+    --pendingCount;
+}
+
+void ShaderCompiler::poll()
+{
+    if (!pendingCount)
+        return;
+
+    for (Job& job : jobs)
+    {
+        if (job.state != State::Compiling || !completed(job))
+            continue;
+
+        resolve(job);
+
+        // Without completion queries every resolve may block
+        if (!parallelCompile)
+            break;
+    }
+}
+
+void ShaderCompiler::finishAll()
+{
+    for (Job& job : jobs)
+    {
+        if (job.state == State::Compiling)
+            resolve(job);
+    }
+}
+
+unsigned int ShaderCompiler::program(Handle handle) const
+{
+    const Job& job = jobs[handle];
+    return job.state == State::Ready ? job.program.get() : placeholder.get();
+}
+
+bool ShaderCompiler::ready(Handle handle) const
+{
+    return jobs[handle].state == State::Ready;
+}
+
+void ShaderCompiler::destroy()
+{
+    // The handles delete whatever each job still holds
+    jobs.clear();
+    pendingCount = 0;
+
+    placeholder.reset();
+}
@@ -0,0 +1,50 @@
+#include <glad/glad.h>
+
+#include <renderer/gl_handle.h>
+#include <renderer/shader_program.h>
+
+#include <iostream>
+
+GlProgram buildShaderProgram(const char* vertexSource, const char* fragmentSource)
+{
+    int success;
+    char infoLog[512];
+
+    // The shader objects are deleted on the way out; the program keeps them
+    GlShader vertexShader = GlShader::create(GL_VERTEX_SHADER);
+    glShaderSource(vertexShader.get(), 1, &vertexSource, nullptr);
+    glCompileShader(vertexShader.get());
+
+    glGetShaderiv(vertexShader.get(), GL_COMPILE_STATUS, &success);
+    if (!success)
+    {
+        glGetShaderInfoLog(vertexShader.get(), 512, nullptr, infoLog);
+        std::cout << "Vertex Shader Error:\n" << infoLog << "\n";
+    }
+
+    GlShader fragmentShader = GlShader::create(GL_FRAGMENT_SHADER);
+    glShaderSource(fragmentShader.get(), 1, &fragmentSource, nullptr);
+    glCompileShader(fragmentShader.get());
+
+    glGetShaderiv(fragmentShader.get(), GL_COMPILE_STATUS, &success);
+    if (!success)
+    {
+        glGetShaderInfoLog(fragmentShader.get(), 512, nullptr, infoLog);
+        std::cout << "Fragment Shader Error:\n" << infoLog << "\n";
+    }
+
+    GlProgram shaderProgram = GlProgram::create();
+    glAttachShader(shaderProgram.get(), vertexShader.get());
+    glAttachShader(shaderProgram.get(), fragmentShader.get());
+
+    glLinkProgram(shaderProgram.get());
+
+    glGetProgramiv(shaderProgram.get(), GL_LINK_STATUS, &success);
+    if (!success)
+    {
+        glGetProgramInfoLog(shaderProgram.get(), 512, nullptr, infoLog);
+        std::cout << "Shader Link Error:\n" << infoLog << "\n";
+    }
+
+    return shaderProgram;
+}
@@ -0,0 +1,94 @@
+#include <renderer/frame_benchmark.h>
+#include <renderer/image_compare.h>
+#include <renderer/image_io.h>
+#include <renderer/instancing.h>
+#include <renderer/software_backend.h>
+#include <renderer/tile_rasterizer.h>
+
+#include <iostream>
+#include <memory>
+
+int runSoftwareBackend(const RenderOptions& options, const char* label, const SoftwareScene& scene, int width, int height)
+{
+    SoftwareFramebuffer framebuffer;
+    framebuffer.resize(width, height);
+
+    unsigned long long frameLimit = options.frames ? options.frames : 1;
+
+    // --threads / --instances go through the binned rasterizer; a plain
+    // run keeps the direct single-threaded path
+    std::unique_ptr<TileRasterizer> binned;
+    std::vector<InstanceData> instances;
+    TileRasterizer::DrawCall draw;
+
+    if (options.threads > 0 || options.instances > 0)
+    {
+        binned = std::make_unique<TileRasterizer>(options.threads ? (unsigned int)options.threads : 1u);
+
+        draw.positions = scene.positions;
+        draw.indices = scene.indices;
+        draw.elementCount = scene.indices ? scene.indexCount : scene.vertexCount;
+        draw.shader = scene.shader;
+
+        if (options.instances > 0)
+        {
+            instances = layoutInstanceGrid(options.instances);
+            draw.instances = instances.data();
+            draw.instanceCount = instances.size();
+        }
+    }
+
+    FrameBenchmark benchmark;
+    if (options.benchmark)
+    {
+        std::string renderer = std::string("software rasterizer (") + SoftwareRasterizer::simdPath();
+        if (binned)
+            renderer += ", " + std::to_string(binned->threads()) + " threads";
+
+        benchmark.start(options.warmupFrames, options.frames, false);
+        benchmark.setRenderer(renderer + ")");
+        frameLimit = options.warmupFrames + options.frames;
+    }
+
+    for (unsigned long long frame = 0; frame < frameLimit; ++frame)
+    {
+        benchmark.beginFrame();
+
+        if (binned)
+        {
+            binned->render(framebuffer, scene.clearColor, draw);
+        }
+        else
+        {
+            framebuffer.clear(scene.clearColor);
+
+            if (scene.indices)
+                SoftwareRasterizer::drawElements(framebuffer, scene.positions, scene.indices, scene.indexCount, scene.shader);
+            else
+                SoftwareRasterizer::drawArrays(framebuffer, scene.positions, scene.vertexCount, scene.shader);
+        }
+
+        // Nothing to present; keep the swap bracket so reports line up
+        benchmark.beginSwap();
+        benchmark.endSwap();
+        benchmark.endFrame();
+    }
+
+    if (options.benchmark)
+    {
+        if (binned)
+            benchmark.addMetric("tasks_stolen", (double)binned->steals());
+        benchmark.report(label, options.benchmarkOut);
+    }
+
+    if (!options.outputPath.empty() || !options.compareReference.empty())
+    {
+        std::vector<unsigned char> pixels = framebuffer.readPixels();
+        if (!options.outputPath.empty() && !writePng(options.outputPath, width, height, pixels.data(), true))
+            return -1;
+        if (!options.compareReference.empty() && !checkReferenceImage(options, pixels.data(), width, height, true))
+            return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,358 @@
+#include <renderer/software_rasterizer.h>
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__AVX2__)
+#define RENDERER_RASTER_AVX2 1
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define RENDERER_RASTER_SSE2 1
+#include <emmintrin.h>
+#endif
+
+static const int TILE = SoftwareFramebuffer::TILE;
+
+// Subpixel precision of window coordinates (28.4 fixed point)
+static const int SUBPIXEL_BITS = 4;
+static const int SUBPIXEL_ONE = 1 << SUBPIXEL_BITS;
+
+// Edge values are clamped into int32 range per tile; anything beyond this
+// is further from the edge than a tile can span, so the sign is kept
+static const std::int64_t EDGE_CLAMP = (std::int64_t)1 << 29;
+
+// No clipping: triangles reaching further out than this (NDC) are dropped
+static const float GUARD_BAND = 16.0f;
+
+// ===============================
+// Framebuffer
+// ===============================
+void SoftwareFramebuffer::resize(int newWidth, int newHeight)
+{
+    width = newWidth;
+    height = newHeight;
+    stride = (newWidth + TILE - 1) / TILE * TILE;
+    paddedHeight = (newHeight + TILE - 1) / TILE * TILE;
+    pixels.assign((size_t)stride * (size_t)paddedHeight, 0);
+}
+
+void SoftwareFramebuffer::clear(const float color[4])
+{
+    std::fill(pixels.begin(), pixels.end(), packColor(color));
+}
+
+std::vector<unsigned char> SoftwareFramebuffer::readPixels() const
+{
+    std::vector<unsigned char> out((size_t)width * (size_t)height * 4);
+    for (int y = 0; y < height; ++y)
+    {
+        const std::uint32_t* src = pixels.data() + (size_t)y * (size_t)stride;
+        unsigned char* dst = out.data() + (size_t)y * (size_t)width * 4;
+        for (int x = 0; x < width; ++x)
+        {
+            dst[x * 4 + 0] = (unsigned char)(src[x] & 0xff);
+            dst[x * 4 + 1] = (unsigned char)((src[x] >> 8) & 0xff);
+            dst[x * 4 + 2] = (unsigned char)((src[x] >> 16) & 0xff);
+            dst[x * 4 + 3] = (unsigned char)(src[x] >> 24);
+        }
+    }
+    return out;
+}
+
+std::uint32_t packColor(const float color[4])
+{
+    std::uint32_t packed = 0;
+    for (int i = 0; i < 4; ++i)
+    {
+        float c = std::min(std::max(color[i], 0.0f), 1.0f);
+        packed |= (std::uint32_t)(c * 255.0f + 0.5f) << (8 * i);
+    }
+    return packed;
+}
+
+// ===============================
+// Tile kernels
+// ===============================
+// e[k]  : edge k at the tile's first pixel center (bias included)
+// dx[k] : change per pixel to the right, dy[k] : per row up
+// A pixel is covered when all three edge values are >= 0, i.e. when the
+// sign bit of (e0 | e1 | e2) is clear.
+
+#if defined(RENDERER_RASTER_AVX2)
+
+static void rasterPartialTile(std::uint32_t* row, int stride, const std::int32_t e[3], const std::int32_t dx[3], const std::int32_t dy[3], std::uint32_t color)
+{
+    const __m256i lane = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    const __m256i colorV = _mm256_set1_epi32((int)color);
+    const __m256i minusOne = _mm256_set1_epi32(-1);
+
+    __m256i e0 = _mm256_add_epi32(_mm256_set1_epi32(e[0]), _mm256_mullo_epi32(lane, _mm256_set1_epi32(dx[0])));
+    __m256i e1 = _mm256_add_epi32(_mm256_set1_epi32(e[1]), _mm256_mullo_epi32(lane, _mm256_set1_epi32(dx[1])));
+    __m256i e2 = _mm256_add_epi32(_mm256_set1_epi32(e[2]), _mm256_mullo_epi32(lane, _mm256_set1_epi32(dx[2])));
+
+    const __m256i step0 = _mm256_set1_epi32(dy[0]);
+    const __m256i step1 = _mm256_set1_epi32(dy[1]);
+    const __m256i step2 = _mm256_set1_epi32(dy[2]);
+
+    for (int r = 0; r < TILE; ++r)
+    {
+        __m256i any = _mm256_or_si256(_mm256_or_si256(e0, e1), e2);
+        __m256i covered = _mm256_cmpgt_epi32(any, minusOne);
+        _mm256_maskstore_epi32((int*)row, covered, colorV);
+
+        e0 = _mm256_add_epi32(e0, step0);
+        e1 = _mm256_add_epi32(e1, step1);
+        e2 = _mm256_add_epi32(e2, step2);
+        row += stride;
+    }
+}
+
+#elif defined(RENDERER_RASTER_SSE2)
+
+static void rasterPartialTile(std::uint32_t* row, int stride, const std::int32_t e[3], const std::int32_t dx[3], const std::int32_t dy[3], std::uint32_t color)
+{
+    const __m128i colorV = _mm_set1_epi32((int)color);
+    const __m128i minusOne = _mm_set1_epi32(-1);
+
+    // SSE2 has no 32-bit multiply, so build the lane offsets up front
+    __m128i lo[3], hi[3], step[3];
+    for (int k = 0; k < 3; ++k)
+    {
+        lo[k] = _mm_setr_epi32(e[k], e[k] + dx[k], e[k] + 2 * dx[k], e[k] + 3 * dx[k]);
+        hi[k] = _mm_add_epi32(lo[k], _mm_set1_epi32(4 * dx[k]));
+        step[k] = _mm_set1_epi32(dy[k]);
+    }
+
+    for (int r = 0; r < TILE; ++r)
+    {
+        __m128i coveredLo = _mm_cmpgt_epi32(_mm_or_si128(_mm_or_si128(lo[0], lo[1]), lo[2]), minusOne);
+        __m128i coveredHi = _mm_cmpgt_epi32(_mm_or_si128(_mm_or_si128(hi[0], hi[1]), hi[2]), minusOne);
+
+        __m128i* dst = (__m128i*)row;
+        __m128i oldLo = _mm_loadu_si128(dst);
+        __m128i oldHi = _mm_loadu_si128(dst + 1);
+        _mm_storeu_si128(dst, _mm_or_si128(_mm_and_si128(coveredLo, colorV), _mm_andnot_si128(coveredLo, oldLo)));
+        _mm_storeu_si128(dst + 1, _mm_or_si128(_mm_and_si128(coveredHi, colorV), _mm_andnot_si128(coveredHi, oldHi)));
+
+        for (int k = 0; k < 3; ++k)
+        {
+            lo[k] = _mm_add_epi32(lo[k], step[k]);
+            hi[k] = _mm_add_epi32(hi[k], step[k]);
+        }
+        row += stride;
+    }
+}
+
+#else
+
+static void rasterPartialTile(std::uint32_t* row, int stride, const std::int32_t e[3], const std::int32_t dx[3], const std::int32_t dy[3], std::uint32_t color)
+{
+    std::int32_t rowE[3] = { e[0], e[1], e[2] };
+
+    for (int r = 0; r < TILE; ++r)
+    {
+        std::int32_t px[3] = { rowE[0], rowE[1], rowE[2] };
+        for (int c = 0; c < TILE; ++c)
+        {
+            if ((px[0] | px[1] | px[2]) >= 0)
+                row[c] = color;
+
+            px[0] += dx[0];
+            px[1] += dx[1];
+            px[2] += dx[2];
+        }
+
+        rowE[0] += dy[0];
+        rowE[1] += dy[1];
+        rowE[2] += dy[2];
+        row += stride;
+    }
+}
+
+#endif
+
+static void fillTile(std::uint32_t* row, int stride, std::uint32_t color)
+{
+    for (int r = 0; r < TILE; ++r)
+    {
+        std::fill_n(row, TILE, color);
+        row += stride;
+    }
+}
+
+const char* SoftwareRasterizer::simdPath()
+{
+#if defined(RENDERER_RASTER_AVX2)
+    return "avx2";
+#elif defined(RENDERER_RASTER_SSE2)
+    return "sse2";
+#else
+    return "scalar";
+#endif
+}
+
+// ===============================
+// Triangle setup
+// ===============================
+void SoftwareRasterizer::toWindowFixed(const SoftwareFramebuffer& target, const float* position, std::int32_t& x, std::int32_t& y)
+{
+    double wx = ((double)position[0] + 1.0) * 0.5 * (double)target.width;
+    double wy = ((double)position[1] + 1.0) * 0.5 * (double)target.height;
+    x = (std::int32_t)std::lround(wx * SUBPIXEL_ONE);
+    y = (std::int32_t)std::lround(wy * SUBPIXEL_ONE);
+}
+
+void SoftwareRasterizer::drawTriangleFixed(
+    SoftwareFramebuffer& target,
+    const std::int32_t x[3],
+    const std::int32_t y[3],
+    std::uint32_t color,
+    int minX, int minY, int maxX, int maxY)
+{
+    std::int64_t area =
+        (std::int64_t)(x[1] - x[0]) * (y[2] - y[0]) -
+        (std::int64_t)(y[1] - y[0]) * (x[2] - x[0]);
+    if (area == 0)
+        return;
+
+    // No culling (GL default): flip clockwise triangles to counter-clockwise
+    int order[3] = { 0, 1, 2 };
+    if (area < 0)
+        std::swap(order[1], order[2]);
+
+    std::int32_t vx[3], vy[3];
+    for (int i = 0; i < 3; ++i)
+    {
+        vx[i] = x[order[i]];
+        vy[i] = y[order[i]];
+    }
+
+    // Pixel p is sampled at p * 16 + 8; >> 4 floors, so this is conservative
+    const int half = SUBPIXEL_ONE / 2;
+    int x0 = std::max(minX, (std::min({ vx[0], vx[1], vx[2] }) - half) >> SUBPIXEL_BITS);
+    int y0 = std::max(minY, (std::min({ vy[0], vy[1], vy[2] }) - half) >> SUBPIXEL_BITS);
+    int x1 = std::min(maxX - 1, (std::max({ vx[0], vx[1], vx[2] }) - half) >> SUBPIXEL_BITS);
+    int y1 = std::min(maxY - 1, (std::max({ vy[0], vy[1], vy[2] }) - half) >> SUBPIXEL_BITS);
+    if (x0 > x1 || y0 > y1)
+        return;
+
+    // Edge k runs from v[k] to v[k+1]; inside is on its left (CCW, y up)
+    std::int64_t stepX[3], stepY[3], bias[3];
+    for (int k = 0; k < 3; ++k)
+    {
+        int next = (k + 1) % 3;
+        std::int32_t edgeDx = vx[next] - vx[k];
+        std::int32_t edgeDy = vy[next] - vy[k];
+
+        stepX[k] = -(std::int64_t)edgeDy;
+        stepY[k] = edgeDx;
+
+        // Top-left rule: samples exactly on a left or top edge are inside,
+        // on any other edge they are not
+        bool left = edgeDy < 0;
+        bool top = edgeDy == 0 && edgeDx < 0;
+        bias[k] = (left || top) ? 0 : -1;
+    }
+
+    std::int32_t dx[3], dy[3];
+    for (int k = 0; k < 3; ++k)
+    {
+        dx[k] = (std::int32_t)(stepX[k] * SUBPIXEL_ONE);
+        dy[k] = (std::int32_t)(stepY[k] * SUBPIXEL_ONE);
+    }
+
+    const std::int64_t span = (TILE - 1) * SUBPIXEL_ONE;
+
+    for (int ty = y0 & ~(TILE - 1); ty <= y1; ty += TILE)
+    {
+        for (int tx = x0 & ~(TILE - 1); tx <= x1; tx += TILE)
+        {
+            std::int64_t sampleX = (std::int64_t)tx * SUBPIXEL_ONE + half;
+            std::int64_t sampleY = (std::int64_t)ty * SUBPIXEL_ONE + half;
+
+            bool outside = false;
+            bool inside = true;
+            std::int32_t e[3];
+
+            for (int k = 0; k < 3; ++k)
+            {
+                std::int64_t value =
+                    stepX[k] * (sampleX - vx[k]) +
+                    stepY[k] * (sampleY - vy[k]) +
+                    bias[k];
+
+                // Extremes of this edge over the tile's 8x8 sample grid
+                std::int64_t high = value + std::max<std::int64_t>(0, stepX[k] * span) + std::max<std::int64_t>(0, stepY[k] * span);
+                std::int64_t low = value + std::min<std::int64_t>(0, stepX[k] * span) + std::min<std::int64_t>(0, stepY[k] * span);
+
+                if (high < 0)
+                {
+                    outside = true;
+                    break;
+                }
+                if (low < 0)
+                    inside = false;
+
+                e[k] = (std::int32_t)std::min(std::max(value, -EDGE_CLAMP), EDGE_CLAMP);
+            }
+
+            if (outside)
+                continue;
+
+            std::uint32_t* tileRow = target.row(ty) + tx;
+            if (inside)
+                fillTile(tileRow, target.stride, color);
+            else
+                rasterPartialTile(tileRow, target.stride, e, dx, dy, color);
+        }
+    }
+}
+
+// ===============================
+// Draw calls
+// ===============================
+static bool inGuardBand(const float* position)
+{
+    return std::fabs(position[0]) <= GUARD_BAND && std::fabs(position[1]) <= GUARD_BAND;
+}
+
+static void drawTriangle(SoftwareFramebuffer& target, const float* a, const float* b, const float* c, std::uint32_t color)
+{
+    if (!inGuardBand(a) || !inGuardBand(b) || !inGuardBand(c))
+        return;
+
+    std::int32_t x[3], y[3];
+    SoftwareRasterizer::toWindowFixed(target, a, x[0], y[0]);
+    SoftwareRasterizer::toWindowFixed(target, b, x[1], y[1]);
+    SoftwareRasterizer::toWindowFixed(target, c, x[2], y[2]);
+
+    SoftwareRasterizer::drawTriangleFixed(target, x, y, color, 0, 0, target.width, target.height);
+}
+
+void SoftwareRasterizer::drawArrays(SoftwareFramebuffer& target, const float* positions, size_t vertexCount, const FlatFragmentShader& shader)
+{
+    std::uint32_t color = packColor(shader.color);
+
+    for (size_t i = 0; i + 2 < vertexCount; i += 3)
+    {
+        drawTriangle(target,
+            positions + (i + 0) * 3,
+            positions + (i + 1) * 3,
+            positions + (i + 2) * 3,
+            color);
+    }
+}
+
+void SoftwareRasterizer::drawElements(SoftwareFramebuffer& target, const float* positions, const unsigned int* indices, size_t indexCount, const FlatFragmentShader& shader)
+{
+    std::uint32_t color = packColor(shader.color);
+
+    for (size_t i = 0; i + 2 < indexCount; i += 3)
+    {
+        drawTriangle(target,
+            positions + (size_t)indices[i + 0] * 3,
+            positions + (size_t)indices[i + 1] * 3,
+            positions + (size_t)indices[i + 2] * 3,
+            color);
+    }
+}
@@ -0,0 +1,138 @@
+#include <glad/glad.h>
+
+#include <renderer/stream_buffer.h>
+
+#include <iostream>
+
+bool StreamBuffer::create(size_t regionSize)
+{
+    regionBytes = regionSize;
+    region = 0;
+    head = 0;
+
+    size_t totalBytes = regionBytes * REGION_COUNT;
+
+    storage = GlBuffer::create();
+    glBindBuffer(GL_COPY_WRITE_BUFFER, storage.get());
+
+    if (GLAD_GL_VERSION_4_4)
+    {
+        const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+        glBufferStorage(GL_COPY_WRITE_BUFFER, (GLsizeiptr)totalBytes, nullptr, flags);
+        mapped = (unsigned char*)glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, (GLsizeiptr)totalBytes, flags);
+        persistentMapping = mapped != nullptr;
+
+        if (!persistentMapping)
+        {
+            std::cout << "Persistent mapping failed, stream buffer disabled\n";
+            destroy();
+            return false;
+        }
+    }
+    else
+    {
+        // Allocated once; regions are only ever mapped unsynchronized
+        glBufferData(GL_COPY_WRITE_BUFFER, (GLsizeiptr)totalBytes, nullptr, GL_STREAM_DRAW);
+    }
+
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    return true;
+}
+
+void StreamBuffer::destroy()
+{
+    for (GlSync& fence : fences)
+        fence.reset();
+
+    if (storage && mapped)
+    {
+        glBindBuffer(GL_COPY_WRITE_BUFFER, storage.get());
+        glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+    }
+
+    storage.reset();
+    mapped = nullptr;
+    persistentMapping = false;
+}
+
+// ===============================
+// Frame boundaries
+// ===============================
+void StreamBuffer::beginFrame()
+{
+    GLsync fence = fences[region].get();
+    if (!fence)
+        return;
+
+    // Only flush on the first attempt; after that we just keep waiting
+    GLenum result = glClientWaitSync(fence, 0, 0);
+    if (result == GL_TIMEOUT_EXPIRED)
+    {
+        ++stallCount;
+        GLbitfield flags = GL_SYNC_FLUSH_COMMANDS_BIT;
+        do
+        {
+            result = glClientWaitSync(fence, flags, 1000000); // 1 ms
+            flags = 0;
+        } while (result == GL_TIMEOUT_EXPIRED);
+    }
+
+    fences[region].reset();
+}
+
+void StreamBuffer::endFrame()
+{
+    commit();
+
+    fences[region] = GlSync::create();
+    region = (region + 1) % REGION_COUNT;
+    head = 0;
+}
+
+// ===============================
+// Allocation
+// ===============================
+StreamBuffer::Allocation StreamBuffer::allocate(size_t size, size_t alignment)
+{
+    Allocation allocation;
+
+    size_t aligned = alignment > 1 ? (head + alignment - 1) / alignment * alignment : head;
+    if (aligned + size > regionBytes)
+        return allocation;
+
+    size_t offset = (size_t)region * regionBytes + aligned;
+    head = aligned + size;
+
+    if (persistentMapping)
+    {
+        allocation.data = mapped + offset;
+    }
+    else
+    {
+        // Fallback: one mapping at a time, safe without syncing because the
+        // region's fence was already waited on in beginFrame()
+        commit();
+        glBindBuffer(GL_COPY_WRITE_BUFFER, storage.get());
+        mapped = (unsigned char*)glMapBufferRange(
+            GL_COPY_WRITE_BUFFER,
+            (GLintptr)offset,
+            (GLsizeiptr)size,
+            GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_INVALIDATE_RANGE_BIT
+        );
+        allocation.data = mapped;
+    }
+
+    allocation.offset = offset;
+    return allocation;
+}
+
+void StreamBuffer::commit()
+{
+    if (persistentMapping || !mapped)
+        return;
+
+    glBindBuffer(GL_COPY_WRITE_BUFFER, storage.get());
+    glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+    mapped = nullptr;
+}
@@ -0,0 +1,125 @@
+#include <renderer/thread_pool.h>
+
+ThreadPool::ThreadPool(unsigned int threadCount)
+{
+    if (threadCount == 0)
+        threadCount = std::thread::hardware_concurrency();
+    if (threadCount == 0)
+        threadCount = 1;
+
+    for (unsigned int i = 0; i < threadCount; ++i)
+        queues.push_back(std::make_unique<Queue>());
+
+    // Worker 0 is whoever calls parallelFor()
+    for (unsigned int i = 1; i < threadCount; ++i)
+        threads.emplace_back(&ThreadPool::workerLoop, this, i);
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        stopping = true;
+    }
+    wake.notify_all();
+
+    for (std::thread& thread : threads)
+        thread.join();
+}
+
+// ===============================
+// Scheduling
+// ===============================
+void ThreadPool::parallelFor(size_t count, const Task& task)
+{
+    if (count == 0)
+        return;
+
+    // Published before any index is queued; workers read it only after
+    // taking an index under a queue mutex, which orders the two
+    currentTask = &task;
+    remaining.store(count);
+
+    size_t workers = queues.size();
+    size_t block = (count + workers - 1) / workers;
+    for (size_t w = 0; w < workers; ++w)
+    {
+        size_t begin = w * block;
+        size_t end = begin + block < count ? begin + block : count;
+
+        std::lock_guard<std::mutex> lock(queues[w]->mutex);
+        for (size_t i = begin; i < end; ++i)
+            queues[w]->items.push_back(i);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        ++generation;
+    }
+    wake.notify_all();
+
+    while (remaining.load(std::memory_order_acquire) != 0)
+    {
+        if (!runOne(0))
+            std::this_thread::yield();
+    }
+}
+
+bool ThreadPool::runOne(unsigned int worker)
+{
+    size_t index = 0;
+    bool found = false;
+
+    // Own queue first, newest item (warmest in cache)
+    {
+        Queue& own = *queues[worker];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.items.empty())
+        {
+            index = own.items.back();
+            own.items.pop_back();
+            found = true;
+        }
+    }
+
+    // Then steal the oldest item of the next non-empty victim
+    for (size_t offset = 1; !found && offset < queues.size(); ++offset)
+    {
+        Queue& victim = *queues[(worker + offset) % queues.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.items.empty())
+        {
+            index = victim.items.front();
+            victim.items.pop_front();
+            found = true;
+            stealCount.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    if (!found)
+        return false;
+
+    (*currentTask)(index, worker);
+    remaining.fetch_sub(1, std::memory_order_release);
+    return true;
+}
+
+void ThreadPool::workerLoop(unsigned int worker)
+{
+    std::uint64_t seen = 0;
+
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> lock(wakeMutex);
+            wake.wait(lock, [&] { return stopping || generation != seen; });
+            if (stopping)
+                return;
+            seen = generation;
+        }
+
+        while (runOne(worker))
+        {
+        }
+    }
+}
@@ -0,0 +1,139 @@
+#include <renderer/tile_rasterizer.h>
+
+#include <algorithm>
+#include <cmath>
+
+// Chunks per thread in the front end, so stealing has something to balance
+static const size_t CHUNKS_PER_THREAD = 4;
+
+// Same limit as the single-threaded path (no clipping)
+static const float GUARD_BAND = 16.0f;
+
+TileRasterizer::TileRasterizer(unsigned int threadCount)
+    : pool(threadCount)
+{
+}
+
+void TileRasterizer::render(SoftwareFramebuffer& target, const float clearColor[4], const DrawCall& draw)
+{
+    binsX = (target.stride + BIN_SIZE - 1) / BIN_SIZE;
+    binsY = (target.paddedHeight + BIN_SIZE - 1) / BIN_SIZE;
+    size_t binCount = (size_t)binsX * (size_t)binsY;
+
+    size_t copies = draw.instances ? draw.instanceCount : 1;
+    triangleCount = (draw.elementCount / 3) * copies;
+    triangles.resize(triangleCount);
+
+    // Front end: setup + binning
+    chunkCount = std::max<size_t>(1, std::min<size_t>(triangleCount, pool.size() * CHUNKS_PER_THREAD));
+    trianglesPerChunk = (triangleCount + chunkCount - 1) / chunkCount;
+
+    chunkBins.resize(chunkCount * binCount);
+    for (std::vector<std::uint32_t>& bin : chunkBins)
+        bin.clear();
+
+    if (triangleCount > 0)
+    {
+        pool.parallelFor(chunkCount, [&](size_t chunk, unsigned int)
+        {
+            binChunk(target, draw, chunk);
+        });
+    }
+
+    // Back end: clear + rasterize each bin
+    std::uint32_t clear = packColor(clearColor);
+    pool.parallelFor(binCount, [&](size_t bin, unsigned int)
+    {
+        rasterBin(target, clear, bin);
+    });
+}
+
+// ===============================
+// Front end
+// ===============================
+void TileRasterizer::binChunk(const SoftwareFramebuffer& target, const DrawCall& draw, size_t chunk)
+{
+    size_t binCount = (size_t)binsX * (size_t)binsY;
+    std::vector<std::uint32_t>* bins = &chunkBins[chunk * binCount];
+
+    size_t perCopy = draw.elementCount / 3;
+    size_t first = chunk * trianglesPerChunk;
+    size_t last = std::min(triangleCount, first + trianglesPerChunk);
+
+    std::uint32_t flatColor = packColor(draw.shader.color);
+    const int half = 8; // half a pixel in 28.4
+
+    for (size_t id = first; id < last; ++id)
+    {
+        size_t copy = id / perCopy;
+        size_t local = id % perCopy;
+
+        const InstanceData* instance = draw.instances ? &draw.instances[copy] : nullptr;
+
+        SetupTriangle& tri = triangles[id];
+        tri.color = instance ? packColor(instance->color) : flatColor;
+
+        bool visible = true;
+        for (int v = 0; v < 3; ++v)
+        {
+            size_t element = local * 3 + (size_t)v;
+            size_t vertex = draw.indices ? draw.indices[element] : element;
+            const float* p = draw.positions + vertex * 3;
+
+            // Same math as instancedVertexShaderSource
+            float position[2] = { p[0], p[1] };
+            if (instance)
+            {
+                position[0] = p[0] * instance->transform[2] + instance->transform[0];
+                position[1] = p[1] * instance->transform[3] + instance->transform[1];
+            }
+
+            if (std::fabs(position[0]) > GUARD_BAND || std::fabs(position[1]) > GUARD_BAND)
+                visible = false;
+
+            SoftwareRasterizer::toWindowFixed(target, position, tri.x[v], tri.y[v]);
+        }
+
+        if (!visible)
+            continue;
+
+        // Pixel bounds, conservative like the rasterizer's own
+        int x0 = std::max(0, (std::min({ tri.x[0], tri.x[1], tri.x[2] }) - half) >> 4);
+        int y0 = std::max(0, (std::min({ tri.y[0], tri.y[1], tri.y[2] }) - half) >> 4);
+        int x1 = std::min(target.width - 1, (std::max({ tri.x[0], tri.x[1], tri.x[2] }) - half) >> 4);
+        int y1 = std::min(target.height - 1, (std::max({ tri.y[0], tri.y[1], tri.y[2] }) - half) >> 4);
+        if (x0 > x1 || y0 > y1)
+            continue;
+
+        for (int by = y0 / BIN_SIZE; by <= y1 / BIN_SIZE; ++by)
+            for (int bx = x0 / BIN_SIZE; bx <= x1 / BIN_SIZE; ++bx)
+                bins[(size_t)by * (size_t)binsX + (size_t)bx].push_back((std::uint32_t)id);
+    }
+}
+
+// ===============================
+// Back end
+// ===============================
+void TileRasterizer::rasterBin(SoftwareFramebuffer& target, std::uint32_t clear, size_t bin)
+{
+    int bx = (int)(bin % (size_t)binsX);
+    int by = (int)(bin / (size_t)binsX);
+
+    int minX = bx * BIN_SIZE;
+    int minY = by * BIN_SIZE;
+    int maxX = std::min(minX + BIN_SIZE, target.stride);
+    int maxY = std::min(minY + BIN_SIZE, target.paddedHeight);
+
+    for (int y = minY; y < maxY; ++y)
+        std::fill(target.row(y) + minX, target.row(y) + maxX, clear);
+
+    size_t binCount = (size_t)binsX * (size_t)binsY;
+    for (size_t chunk = 0; chunk < chunkCount; ++chunk)
+    {
+        for (std::uint32_t id : chunkBins[chunk * binCount + bin])
+        {
+            const SetupTriangle& tri = triangles[id];
+            SoftwareRasterizer::drawTriangleFixed(target, tri.x, tri.y, tri.color, minX, minY, maxX, maxY);
+        }
+    }
+}
@@ -0,0 +1,124 @@
+#include <glad/glad.h>
+
+#include <renderer/offscreen_context.h>
+
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+
+// ===============================
+// GladGLContext dispatch tables
+// ===============================
+// Failed loads leave the table zeroed; two contexts on two threads each
+// render through their own table while the glad_gl* globals stay unloaded
+
+static int failures = 0;
+
+static void expect(const char* name, bool ok)
+{
+    std::printf("%s: %s\n", ok ? "ok  " : "FAIL", name);
+    if (!ok)
+        ++failures;
+}
+
+static bool isZeroed(const GladGLContext& context)
+{
+    static const GladGLContext zero = {};
+    return std::memcmp(&context, &zero, sizeof context) == 0;
+}
+
+// A driver that reports version 0.0 and resolves nothing else
+static const GLubyte* APIENTRY zeroVersionString(GLenum)
+{
+    return (const GLubyte*)"0.0";
+}
+
+static void* zeroVersionLoader(const char* name)
+{
+    return std::strcmp(name, "glGetString") == 0 ? (void*)zeroVersionString : nullptr;
+}
+
+static void* nullLoader(const char*)
+{
+    return nullptr;
+}
+
+// ===============================
+// One thread per context
+// ===============================
+struct ThreadResult
+{
+    bool created = false;
+    bool loaded = false;
+    unsigned char pixel[4] = {};
+};
+
+static std::atomic<int> ready{ 0 };
+
+static void renderThread(float red, float green, ThreadResult& result)
+{
+    OffscreenContext offscreen;
+    result.created = offscreen.create(1, 1);
+
+    GladGLContext gl;
+    result.loaded = result.created && gladLoadGLContext(&gl, (GLADloadproc)OffscreenContext::getProcAddress);
+
+    // Both contexts exist before either draws
+    ++ready;
+    while (ready.load() < 2)
+        std::this_thread::yield();
+
+    if (!result.loaded)
+        return;
+
+    GLuint framebuffer = 0, renderbuffer = 0;
+    gl.GenRenderbuffers(1, &renderbuffer);
+    gl.BindRenderbuffer(GL_RENDERBUFFER, renderbuffer);
+    gl.RenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, 1, 1);
+    gl.GenFramebuffers(1, &framebuffer);
+    gl.BindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    gl.FramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, renderbuffer);
+
+    gl.Viewport(0, 0, 1, 1);
+    gl.ClearColor(red, green, 0.0f, 1.0f);
+    gl.Clear(GL_COLOR_BUFFER_BIT);
+    gl.ReadPixels(0, 0, 1, 1, GL_RGBA, GL_UNSIGNED_BYTE, result.pixel);
+
+    gl.DeleteFramebuffers(1, &framebuffer);
+    gl.DeleteRenderbuffers(1, &renderbuffer);
+    gladFreeGLContext(&gl);
+}
+
+int main()
+{
+    GladGLContext context;
+
+    std::memset(&context, 0xAB, sizeof context);
+    expect("no glGetString fails", gladLoadGLContext(&context, nullLoader) == 0);
+    expect("no glGetString leaves the table zeroed", isZeroed(context));
+
+    std::memset(&context, 0xAB, sizeof context);
+    expect("version 0.0 fails", gladLoadGLContext(&context, zeroVersionLoader) == 0);
+    expect("version 0.0 leaves the table zeroed", isZeroed(context));
+
+    ThreadResult first, second;
+    std::thread a(renderThread, 1.0f, 0.0f, std::ref(first));
+    std::thread b(renderThread, 0.0f, 1.0f, std::ref(second));
+    a.join();
+    b.join();
+
+    // No EGL here (ctest counts 77 as skipped)
+    if (!first.created || !second.created)
+    {
+        std::printf("skip: no headless GL context\n");
+        return failures == 0 ? 77 : 1;
+    }
+
+    expect("both tables load", first.loaded && second.loaded);
+    expect("first thread reads back red", first.pixel[0] == 255 && first.pixel[1] == 0);
+    expect("second thread reads back green", second.pixel[0] == 0 && second.pixel[1] == 255);
+    expect("globals stay unloaded", glad_glClear == nullptr && glad_glGetString == nullptr);
+
+    return failures == 0 ? 0 : 1;
+}
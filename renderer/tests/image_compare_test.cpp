@@ -0,0 +1,71 @@
+#include <renderer/image_compare.h>
+
+#include <cstdio>
+#include <vector>
+
+// ===============================
+// compareImages() pass / fail rules
+// ===============================
+// A 256x192 frame, dark background, one 64x48 shape in the middle
+
+static const int WIDTH = 256;
+static const int HEIGHT = 192;
+
+static std::vector<unsigned char> scene(int shiftX, int brighten)
+{
+    std::vector<unsigned char> rgba((size_t)WIDTH * HEIGHT * 4);
+    for (int y = 0; y < HEIGHT; ++y)
+    {
+        for (int x = 0; x < WIDTH; ++x)
+        {
+            unsigned char* p = &rgba[((size_t)y * WIDTH + x) * 4];
+            bool inside = x >= 96 + shiftX && x < 160 + shiftX && y >= 72 && y < 120;
+            p[0] = inside ? (unsigned char)(200 + brighten) : 20;
+            p[1] = inside ? (unsigned char)(120 + brighten) : 30;
+            p[2] = inside ? (unsigned char)(40 + brighten) : 30;
+            p[3] = 255;
+        }
+    }
+    return rgba;
+}
+
+static int failures = 0;
+
+static void expect(const char* name, const std::vector<unsigned char>& image, const std::vector<unsigned char>& reference,
+    bool shouldMatch)
+{
+    RenderOptions defaults;
+    ImageDiff diff = compareImages(image.data(), reference.data(), WIDTH, HEIGHT, (int)defaults.compareTolerance,
+        defaults.compareMaxBad, defaults.compareMinSsim);
+
+    bool ok = diff.matches == shouldMatch;
+    std::printf("%s: %s (%llu bad pixels, worst block SSIM %.4f)\n", ok ? "ok  " : "FAIL", name, diff.badPixels, diff.ssim);
+    if (!ok)
+        ++failures;
+}
+
+int main()
+{
+    std::vector<unsigned char> reference = scene(0, 0);
+
+    expect("identical", scene(0, 0), reference, true);
+
+    // Within tolerance everywhere
+    expect("shape 2 levels brighter", scene(0, 2), reference, true);
+
+    // The regression a frame-wide SSIM mean used to wave through
+    expect("shape recolored by 20 levels", scene(0, 20), reference, false);
+
+    expect("shape moved 3 pixels", scene(3, 0), reference, false);
+
+    // A few pixels of rounding noise
+    std::vector<unsigned char> noisy = reference;
+    for (int i = 0; i < 20; ++i)
+        noisy[((size_t)(i * 9) * WIDTH + (size_t)(i * 13)) * 4] += 5;
+    expect("scattered rounding noise", noisy, reference, true);
+
+    // Missing shape
+    expect("shape missing", scene(1000, 0), reference, false);
+
+    return failures == 0 ? 0 : 1;
+}
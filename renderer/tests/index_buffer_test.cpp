@@ -0,0 +1,182 @@
+#include <glad/glad.h>
+
+#include <renderer/index_buffer.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+// ===============================
+// buildIndexBuffer() type choice and 64K chunking
+// ===============================
+// Meshes are grids of quads, two triangles each, emitted row by row; a
+// row only references its own and the next row of vertices
+
+static const size_t SHORT_RANGE = 65536;
+
+static int failures = 0;
+
+static void expect(const char* name, bool ok)
+{
+    std::printf("%s: %s\n", ok ? "ok  " : "FAIL", name);
+    if (!ok)
+        ++failures;
+}
+
+static std::vector<unsigned int> grid(unsigned int columns, unsigned int rows)
+{
+    std::vector<unsigned int> indices;
+    unsigned int stride = columns + 1;
+    for (unsigned int y = 0; y < rows; ++y)
+    {
+        for (unsigned int x = 0; x < columns; ++x)
+        {
+            unsigned int corner = y * stride + x;
+            unsigned int quad[6] = { corner, corner + 1, corner + stride, corner + 1, corner + stride + 1, corner + stride };
+            indices.insert(indices.end(), quad, quad + 6);
+        }
+    }
+    return indices;
+}
+
+// Index `i` of the buffer as drawn: packed value plus its chunk's base vertex
+static unsigned int drawnIndex(const IndexBuffer& buffer, const IndexChunk& chunk, size_t i)
+{
+    const unsigned char* bytes = buffer.bytes.data() + i * buffer.indexSize;
+    unsigned int value = 0;
+    if (buffer.indexSize == 1)
+    {
+        value = bytes[0];
+    }
+    else if (buffer.indexSize == 2)
+    {
+        std::uint16_t narrow;
+        std::memcpy(&narrow, bytes, 2);
+        value = narrow;
+    }
+    else
+    {
+        std::memcpy(&value, bytes, 4);
+    }
+    return value + (unsigned int)chunk.baseVertex;
+}
+
+static bool drawsOriginal(const IndexBuffer& buffer, const std::vector<unsigned int>& indices)
+{
+    if (buffer.bytes.size() != indices.size() * buffer.indexSize)
+        return false;
+
+    for (const IndexChunk& chunk : buffer.chunks)
+    {
+        for (size_t i = chunk.firstIndex; i < chunk.firstIndex + chunk.indexCount; ++i)
+        {
+            if (drawnIndex(buffer, chunk, i) != indices[i])
+                return false;
+        }
+    }
+    return true;
+}
+
+// Chunks cover the mesh in order, whole triangles each
+static bool chunksTile(const IndexBuffer& buffer, size_t indexCount)
+{
+    size_t next = 0;
+    for (const IndexChunk& chunk : buffer.chunks)
+    {
+        if (chunk.firstIndex != next || chunk.indexCount == 0 || chunk.indexCount % 3 != 0)
+            return false;
+        next += chunk.indexCount;
+    }
+    return next == indexCount;
+}
+
+static void span(const std::vector<unsigned int>& indices, size_t first, size_t count, unsigned int& low, unsigned int& high)
+{
+    low = high = indices[first];
+    for (size_t i = first; i < first + count; ++i)
+    {
+        low = indices[i] < low ? indices[i] : low;
+        high = indices[i] > high ? indices[i] : high;
+    }
+}
+
+// Every chunk fits 16 bits, and each but the last would not with its next triangle
+static bool chunksAreMaximal(const IndexBuffer& buffer, const std::vector<unsigned int>& indices)
+{
+    for (size_t c = 0; c < buffer.chunks.size(); ++c)
+    {
+        const IndexChunk& chunk = buffer.chunks[c];
+        unsigned int low, high;
+        span(indices, chunk.firstIndex, chunk.indexCount, low, high);
+        if (high - low >= SHORT_RANGE || (int)low != chunk.baseVertex)
+            return false;
+
+        if (c + 1 < buffer.chunks.size())
+        {
+            span(indices, chunk.firstIndex, chunk.indexCount + 3, low, high);
+            if (high - low < SHORT_RANGE)
+                return false;
+        }
+    }
+    return true;
+}
+
+int main()
+{
+    expect("256 vertices fit a byte", indexTypeFor(256) == GL_UNSIGNED_BYTE);
+    expect("257 vertices need a short", indexTypeFor(257) == GL_UNSIGNED_SHORT);
+    expect("65536 vertices fit a short", indexTypeFor(65536) == GL_UNSIGNED_SHORT);
+    expect("65537 vertices need an int", indexTypeFor(65537) == GL_UNSIGNED_INT);
+
+    // 11 x 11 vertices
+    std::vector<unsigned int> small = grid(10, 10);
+    IndexBuffer bytes = buildIndexBuffer(small.data(), small.size(), 121);
+    expect("small mesh packs to bytes", bytes.type == GL_UNSIGNED_BYTE && bytes.chunks.size() == 1 && drawsOriginal(bytes, small));
+    expect("small mesh saves 3 bytes per index", bytes.bytesSaved() == small.size() * 3);
+
+    IndexBuffer wide = buildIndexBuffer(small.data(), small.size(), 121, false);
+    expect("--wide-indices keeps 32-bit", wide.type == GL_UNSIGNED_INT && wide.chunks.size() == 1 && drawsOriginal(wide, small));
+
+    // 101 x 101 vertices
+    std::vector<unsigned int> medium = grid(100, 100);
+    IndexBuffer shorts = buildIndexBuffer(medium.data(), medium.size(), 101 * 101);
+    expect("medium mesh packs to shorts", shorts.type == GL_UNSIGNED_SHORT && shorts.chunks.size() == 1 && drawsOriginal(shorts, medium));
+
+    // 301 x 301 vertices: past 16 bits, but a row spans only 602 of them
+    std::vector<unsigned int> large = grid(300, 300);
+    IndexBuffer chunked = buildIndexBuffer(large.data(), large.size(), 301 * 301);
+    expect("large mesh is chunked into shorts", chunked.type == GL_UNSIGNED_SHORT && chunked.chunks.size() > 1);
+    expect("chunks tile the mesh", chunksTile(chunked, large.size()));
+    expect("chunks break only where 16 bits run out", chunksAreMaximal(chunked, large));
+    expect("rebased chunks draw the original indices", drawsOriginal(chunked, large));
+    expect("chunks average MIN_CHUNK_INDICES", chunked.chunks.size() * IndexBuffer::MIN_CHUNK_INDICES <= large.size());
+
+    // 1001 x 70 vertices: fewer, longer rows per chunk
+    std::vector<unsigned int> longRows = grid(1000, 69);
+    IndexBuffer rows = buildIndexBuffer(longRows.data(), longRows.size(), 1001 * 70);
+    expect("long rows chunk the same way", rows.type == GL_UNSIGNED_SHORT && rows.chunks.size() > 1
+        && chunksAreMaximal(rows, longRows) && drawsOriginal(rows, longRows));
+
+    // One triangle reaching across more than 65536 vertices
+    std::vector<unsigned int> far = large;
+    unsigned int stray[3] = { 0, 70000, 1 };
+    far.insert(far.end(), stray, stray + 3);
+    IndexBuffer unsplittable = buildIndexBuffer(far.data(), far.size(), 301 * 301);
+    expect("a triangle spanning > 64K stays 32-bit", unsplittable.type == GL_UNSIGNED_INT && unsplittable.chunks.size() == 1
+        && drawsOriginal(unsplittable, far));
+
+    // Triangles alternating between both ends: one chunk each, too many draws
+    std::vector<unsigned int> scattered;
+    for (unsigned int i = 0; i < 1000; ++i)
+    {
+        unsigned int base = (i % 2) ? 80000 + i : i;
+        unsigned int tri[3] = { base, base + 1, base + 2 };
+        scattered.insert(scattered.end(), tri, tri + 3);
+    }
+    IndexBuffer poor = buildIndexBuffer(scattered.data(), scattered.size(), 90000);
+    expect("poor locality stays 32-bit in one piece", poor.type == GL_UNSIGNED_INT && poor.chunks.size() == 1
+        && drawsOriginal(poor, scattered));
+
+    return failures == 0 ? 0 : 1;
+}